@@ -2,6 +2,7 @@
 // Copyright Contributors to the DJV project.
 
 #include <djvApp/App.h>
+#include <djvApp/StartupProfiler.h>
 
 #include <tlTimelineUI/Init.h>
 #include <tlDevice/Init.h>
@@ -25,14 +26,23 @@ FTK_MAIN()
     try
     {
         auto context = ftk::Context::create();
-        tl::timelineui::init(context);
-        tl::device::init(context);
+        auto startupProfiler = djv::app::StartupProfiler::create(context);
+        {
+            djv::app::StartupProfilerScope scope(context, "Plugin init", "Plugins");
+            tl::timelineui::init(context);
+            tl::device::init(context);
+        }
         auto args = ftk::convert(argc, argv);
-        auto app = djv::app::App::create(context, args);
+        std::shared_ptr<djv::app::App> app;
+        {
+            djv::app::StartupProfilerScope scope(context, "Command line");
+            app = djv::app::App::create(context, args);
+        }
         r = app->getExit();
         if (0 == r)
         {
             app->run();
+            r = app->getExportStatus();
         }
     }
     catch(const std::exception& e)
@@ -50,6 +50,8 @@ namespace djv
                 { "View", "Toggle the view tool." },
                 { "ColorPicker", "Toggle the color picker tool." },
                 { "ColorControls", "Toggle the color controls tool." },
+                { "Scopes", "Toggle the scopes tool." },
+                { "Statistics", "Toggle the statistics tool." },
                 { "Info", "Toggle the information tool." },
                 { "Audio", "Toggle the audio tool." },
                 { "Devices", "Toggle the devices tool." },
@@ -20,6 +20,7 @@ namespace djv
             std::shared_ptr<ftk::ValueObserver<tl::timeline::DisplayOptions> > displayOptionsObserver;
             std::shared_ptr<ftk::ValueObserver<tl::timeline::ForegroundOptions> > fgOptionsObserver;
             std::shared_ptr<ftk::ValueObserver<bool> > hudObserver;
+            std::shared_ptr<ftk::ValueObserver<bool> > hudGraphObserver;
         };
 
         void ViewActions::_init(
@@ -178,6 +179,16 @@ namespace djv
                     }
                 });
 
+            _actions["HUDGraph"] = ftk::Action::create(
+                "HUD Frame Timing",
+                [appWeak](bool value)
+                {
+                    if (auto app = appWeak.lock())
+                    {
+                        app->getViewportModel()->setHUDGraph(value);
+                    }
+                });
+
             _tooltips =
             {
                 { "Frame",  "Frame the view to fit the window." },
@@ -185,7 +196,8 @@ namespace djv
                 { "ZoomIn", "Zoom the view in." },
                 { "ZoomOut", "Zoom the view out." },
                 { "Grid", "Toggle the grid." },
-                { "HUD", "Toggle the HUD (Heads Up Display)." }
+                { "HUD", "Toggle the HUD (Heads Up Display)." },
+                { "HUDGraph", "Toggle the frame timing graph in the HUD." }
             };
 
             _shortcutsUpdate(app->getSettingsModel()->getShortcuts());
@@ -223,6 +235,13 @@ namespace djv
                 {
                     _actions["HUD"]->setChecked(value);
                 });
+
+            p.hudGraphObserver = ftk::ValueObserver<bool>::create(
+                app->getViewportModel()->observeHUDGraph(),
+                [this](bool value)
+                {
+                    _actions["HUDGraph"]->setChecked(value);
+                });
         }
 
         ViewActions::ViewActions() :
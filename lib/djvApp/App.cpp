@@ -5,8 +5,10 @@
 
 #include <djvApp/Models/AudioModel.h>
 #include <djvApp/Models/ColorModel.h>
+#include <djvApp/Models/ExportModel.h>
 #include <djvApp/Models/FilesModel.h>
 #include <djvApp/Models/RecentFilesModel.h>
+#include <djvApp/Models/StatsModel.h>
 #include <djvApp/Models/TimeUnitsModel.h>
 #include <djvApp/Models/ToolsModel.h>
 #include <djvApp/Models/ViewportModel.h>
@@ -15,10 +17,12 @@
 #endif // TLRENDER_BMD
 #include <djvApp/Widgets/SeparateAudioDialog.h>
 #include <djvApp/Widgets/Viewport.h>
+#include <djvApp/Exporter.h>
 #include <djvApp/MainWindow.h>
+#include <djvApp/ProbeCache.h>
+#include <djvApp/Process.h>
 #include <djvApp/SecondaryWindow.h>
-
-#include <tlTimelineUI/ThumbnailSystem.h>
+#include <djvApp/StartupProfiler.h>
 
 #include <tlTimeline/ColorOptions.h>
 #include <tlTimeline/CompareOptions.h>
@@ -41,11 +45,24 @@
 
 #include <ftk/UI/FileBrowser.h>
 #include <ftk/UI/Settings.h>
+#include <ftk/GL/Window.h>
 #include <ftk/Core/CmdLine.h>
 #include <ftk/Core/File.h>
 #include <ftk/Core/Format.h>
+#include <ftk/Core/String.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
 #include <filesystem>
+#include <future>
+#include <iostream>
+#include <list>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
 
 namespace djv
 {
@@ -71,6 +88,10 @@ namespace djv
             std::shared_ptr<ftk::CmdLineValueOption<std::string> > ocioLook;
             std::shared_ptr<ftk::CmdLineValueOption<std::string> > lutFileName;
             std::shared_ptr<ftk::CmdLineValueOption<tl::timeline::LUTOrder> > lutOrder;
+            std::shared_ptr<ftk::CmdLineValueOption<std::string> > exportFileName;
+            std::shared_ptr<ftk::CmdLineValueOption<std::string> > exportShard;
+            std::shared_ptr<ftk::CmdLineValueOption<ExportShardMode> > exportShardMode;
+            std::shared_ptr<ftk::CmdLineValueOption<int> > exportProcesses;
 #if defined(TLRENDER_USD)
             std::shared_ptr<ftk::CmdLineValueOption<int> > usdRenderWidth;
             std::shared_ptr<ftk::CmdLineValueOption<float> > usdComplexity;
@@ -83,28 +104,75 @@ namespace djv
             std::shared_ptr<ftk::CmdLineValueOption<std::string> > logFileName;
             std::shared_ptr<ftk::CmdLineFlagOption> resetSettings;
             std::shared_ptr<ftk::CmdLineValueOption<std::string> > settingsFileName;
+            std::shared_ptr<ftk::CmdLineValueOption<std::string> > profileStartup;
         };
 
         struct App::Private
         {
             std::filesystem::path logFile;
             std::filesystem::path settingsFile;
+            std::vector<std::string> argv;
             CmdLine cmdLine;
 
             std::shared_ptr<tl::file::FileLogSystem> fileLogSystem;
             std::shared_ptr<ftk::Settings> settings;
+            std::shared_ptr<ProbeCache> probeCache;
             std::shared_ptr<SettingsModel> settingsModel;
             std::shared_ptr<TimeUnitsModel> timeUnitsModel;
             std::shared_ptr<FilesModel> filesModel;
             std::vector<std::shared_ptr<FilesModelItem> > files;
+            std::unordered_map<std::shared_ptr<FilesModelItem>, size_t> filesIndexes;
             std::vector<std::shared_ptr<FilesModelItem> > activeFiles;
             std::shared_ptr<RecentFilesModel> recentFilesModel;
             std::vector<std::shared_ptr<tl::timeline::Timeline> > timelines;
             std::shared_ptr<ftk::ObservableValue<std::shared_ptr<tl::timeline::Player> > > player;
+            std::optional<tl::timeline::Loop> cmdLineLoop;
+            std::optional<tl::timeline::Playback> cmdLinePlayback;
+            int exportStatus = 0;
+
+            struct TimelineLoad
+            {
+                std::shared_ptr<FilesModelItem> item;
+                std::shared_ptr<std::atomic<FilesModelLoadStage> > stage;
+                std::shared_ptr<std::vector<FileStamp> > stamps;
+                std::shared_ptr<bool> stampsValid;
+                std::future<std::shared_ptr<tl::timeline::Timeline> > future;
+            };
+            size_t timelineLoadMax = 1;
+            std::list<std::shared_ptr<FilesModelItem> > timelineQueue;
+            std::list<TimelineLoad> timelineLoads;
+
+            struct StampsLoad
+            {
+                std::shared_ptr<FilesModelItem> item;
+                size_t generation = 0;
+                std::future<std::vector<FileStamp> > future;
+            };
+            std::list<StampsLoad> stampsLoads;
+            std::set<std::shared_ptr<FilesModelItem> > timelinesPending;
+            std::unordered_map<std::shared_ptr<FilesModelItem>, std::chrono::steady_clock::time_point> timelinesInactive;
+            std::vector<std::shared_ptr<FilesModelItem> > timelinesWanted;
+
+            struct Standby
+            {
+                std::shared_ptr<FilesModelItem> item;
+                std::shared_ptr<tl::timeline::Player> player;
+            };
+            Standby standby;
+
+            struct PoolPlayer
+            {
+                std::shared_ptr<FilesModelItem> item;
+                std::shared_ptr<tl::timeline::Player> player;
+                tl::timeline::PlayerCacheOptions cache;
+            };
+            std::list<PoolPlayer> playerPool;
             std::shared_ptr<ColorModel> colorModel;
             std::shared_ptr<ViewportModel> viewportModel;
             std::shared_ptr<AudioModel> audioModel;
             std::shared_ptr<ToolsModel> toolsModel;
+            std::shared_ptr<ExportModel> exportModel;
+            std::shared_ptr<StatsModel> statsModel;
 
             std::shared_ptr<ftk::ObservableValue<bool> > secondaryWindowActive;
             std::shared_ptr<MainWindow> mainWindow;
@@ -119,6 +187,7 @@ namespace djv
 #endif // TLRENDER_BMD
 
             std::shared_ptr<ftk::ValueObserver<tl::timeline::PlayerCacheOptions> > cacheObserver;
+            std::shared_ptr<ftk::ValueObserver<AdvancedSettings> > advancedObserver;
             std::shared_ptr<ftk::ListObserver<std::shared_ptr<FilesModelItem> > > filesObserver;
             std::shared_ptr<ftk::ListObserver<std::shared_ptr<FilesModelItem> > > activeObserver;
             std::shared_ptr<ftk::ListObserver<int> > layersObserver;
@@ -153,10 +222,12 @@ namespace djv
         {
             FTK_P();
 
+            p.argv = argv;
             const std::string appName = "djv";
             const std::filesystem::path appDocsPath = _appDocsPath();
             p.logFile = _getLogFilePath(appName, appDocsPath);
             p.settingsFile = _getSettingsPath(appName, appDocsPath);
+            p.timelineLoadMax = std::max(1U, std::thread::hardware_concurrency());
 
             p.cmdLine.inputs = ftk::CmdLineListArg<std::string>::create(
                 "input",
@@ -240,6 +311,28 @@ namespace djv
                 "Color",
                 std::optional<tl::timeline::LUTOrder>(),
                 ftk::quotes(tl::timeline::getLUTOrderLabels()));
+            p.cmdLine.exportFileName = ftk::CmdLineValueOption<std::string>::create(
+                { "-export" },
+                "Export the input to the given file without opening a window "
+                "(e.g., render.0001.exr or render.mov). The in/out range, color, "
+                "and export settings are used.",
+                "Export");
+            p.cmdLine.exportShard = ftk::CmdLineValueOption<std::string>::create(
+                { "-exportShard" },
+                "Export a shard of the in/out range (e.g., 3/8 for the third of "
+                "eight shards). Only image sequences can be split into shards.",
+                "Export");
+            p.cmdLine.exportShardMode = ftk::CmdLineValueOption<ExportShardMode>::create(
+                { "-exportShardMode" },
+                "How the frames are split into shards.",
+                "Export",
+                ExportShardMode::Interleaved,
+                ftk::quotes(getExportShardModeLabels()));
+            p.cmdLine.exportProcesses = ftk::CmdLineValueOption<int>::create(
+                { "-exportProcesses" },
+                "Split the export into shards and run them in the given number "
+                "of processes.",
+                "Export");
 #if defined(TLRENDER_USD)
             p.cmdLine.usdRenderWidth = ftk::CmdLineValueOption<int>::create(
                 { "-usdRenderWidth" },
@@ -291,6 +384,10 @@ namespace djv
                 "Settings file name.",
                 std::string(),
                 ftk::Format("{0}").arg(p.settingsFile.u8string()));
+            p.cmdLine.profileStartup = ftk::CmdLineValueOption<std::string>::create(
+                { "-profileStartup" },
+                "Write the startup timings to a Chrome trace file. The timings "
+                "are written when the first frame is displayed.");
 
             ftk::App::_init(
                 context,
@@ -316,6 +413,10 @@ namespace djv
                     p.cmdLine.ocioLook,
                     p.cmdLine.lutFileName,
                     p.cmdLine.lutOrder,
+                    p.cmdLine.exportFileName,
+                    p.cmdLine.exportShard,
+                    p.cmdLine.exportShardMode,
+                    p.cmdLine.exportProcesses,
 #if defined(TLRENDER_USD)
                     p.cmdLine.usdRenderWidth,
                     p.cmdLine.usdComplexity,
@@ -327,7 +428,8 @@ namespace djv
 #endif // TLRENDER_USD
                     p.cmdLine.logFileName,
                     p.cmdLine.resetSettings,
-                    p.cmdLine.settingsFileName
+                    p.cmdLine.settingsFileName,
+                    p.cmdLine.profileStartup
                 });
         }
 
@@ -336,7 +438,14 @@ namespace djv
         {}
 
         App::~App()
-        {}
+        {
+            // Write the startup timings if the first frame was not
+            // displayed.
+            if (auto startupProfiler = _context->getSystem<StartupProfiler>())
+            {
+                startupProfiler->finish();
+            }
+        }
 
         std::shared_ptr<App> App::create(
             const std::shared_ptr<ftk::Context>& context,
@@ -382,12 +491,17 @@ namespace djv
             FTK_P();
             tl::file::PathOptions pathOptions;
             pathOptions.maxNumberDigits = p.settingsModel->getImageSequence().maxDigits;
+            std::vector<std::shared_ptr<FilesModelItem> > items;
             for (const auto& i : tl::timeline::getPaths(_context, path, pathOptions))
             {
                 auto item = std::make_shared<FilesModelItem>();
                 item->path = i;
                 item->audioPath = audioPath;
-                p.filesModel->add(item);
+                items.push_back(item);
+            }
+            if (!items.empty())
+            {
+                p.filesModel->add(items);
                 p.recentFilesModel->addRecent(path.get());
             }
         }
@@ -420,20 +534,62 @@ namespace djv
         void App::reload()
         {
             FTK_P();
+
+            // Only reload the active files that have changed on disk, or
+            // that were not loaded. Files that have changed get a new
+            // generation so that their cached frames and thumbnails are not
+            // used, while the cached data for the other files is kept.
             const auto activeFiles = p.activeFiles;
-            const auto files = p.files;
-            for (const auto& i : activeFiles)
+            bool changed = false;
+            bool aChanged = false;
+            for (size_t i = 0; i < activeFiles.size(); ++i)
             {
-                const auto j = std::find(p.files.begin(), p.files.end(), i);
-                if (j != p.files.end())
+                const auto& item = activeFiles[i];
+                const FilesModelLoad status = item->load->get().status;
+                if (FilesModelLoad::Queued == status ||
+                    FilesModelLoad::Loading == status)
+                {
+                    continue;
+                }
+                if (FilesModelLoad::Ready == status && !_reloadCheck(item))
                 {
-                    const size_t index = j - p.files.begin();
-                    p.files.erase(j);
-                    p.timelines.erase(p.timelines.begin() + index);
+                    continue;
+                }
+                _reloadReset(item);
+                changed = true;
+                if (0 == i)
+                {
+                    aChanged = true;
                 }
             }
-            p.activeFiles.clear();
-            if (!activeFiles.empty())
+
+            // The standby and pooled players also hold frames of their
+            // files, so their players are dropped when the files change.
+            bool standbyChanged = false;
+            if (p.standby.item &&
+                FilesModelLoad::Ready == p.standby.item->load->get().status &&
+                _reloadCheck(p.standby.item))
+            {
+                _reloadReset(p.standby.item);
+                p.standby.player.reset();
+                standbyChanged = true;
+            }
+            auto j = p.playerPool.begin();
+            while (j != p.playerPool.end())
+            {
+                if (FilesModelLoad::Ready == j->item->load->get().status &&
+                    _reloadCheck(j->item))
+                {
+                    _reloadReset(j->item);
+                    j = p.playerPool.erase(j);
+                }
+                else
+                {
+                    ++j;
+                }
+            }
+
+            if (aChanged)
             {
                 if (auto player = p.player->get())
                 {
@@ -441,13 +597,17 @@ namespace djv
                     activeFiles.front()->currentTime = player->getCurrentTime();
                     activeFiles.front()->inOutRange = player->getInOutRange();
                 }
+                p.activeFiles.clear();
+            }
+            if (changed)
+            {
+                _activeUpdate(activeFiles);
+            }
+            else if (standbyChanged)
+            {
+                _timelinesQueue(p.activeFiles, p.standby.item);
+                _playerCacheUpdate();
             }
-
-            auto thumbnailSytem = _context->getSystem<tl::timelineui::ThumbnailSystem>();
-            thumbnailSytem->getCache()->clear();
-
-            _filesUpdate(files);
-            _activeUpdate(activeFiles);
         }
 
         std::shared_ptr<ftk::IObservableValue<std::shared_ptr<tl::timeline::Player> > > App::observePlayer() const
@@ -475,6 +635,16 @@ namespace djv
             return _p->toolsModel;
         }
 
+        const std::shared_ptr<ExportModel>& App::getExportModel() const
+        {
+            return _p->exportModel;
+        }
+
+        const std::shared_ptr<StatsModel>& App::getStatsModel() const
+        {
+            return _p->statsModel;
+        }
+
         const std::shared_ptr<MainWindow>& App::getMainWindow() const
         {
             return _p->mainWindow;
@@ -528,29 +698,97 @@ namespace djv
         {
             FTK_P();
 
-            p.fileLogSystem = tl::file::FileLogSystem::create(_context, p.logFile);
+            auto startupProfiler = StartupProfiler::create(_context);
+            if (p.cmdLine.profileStartup->hasValue())
+            {
+                startupProfiler->setFileName(p.cmdLine.profileStartup->getValue());
+            }
+            else
+            {
+                // Stop recording since the timings will not be written.
+                startupProfiler->finish();
+            }
 
-            p.settings = ftk::Settings::create(
-                _context,
-                p.settingsFile,
-                p.cmdLine.resetSettings->found());
+            {
+                StartupProfilerScope scope(_context, "Settings");
+                if (p.cmdLine.logFileName->hasValue())
+                {
+                    p.logFile = std::filesystem::u8path(p.cmdLine.logFileName->getValue());
+                }
+                if (p.cmdLine.settingsFileName->hasValue())
+                {
+                    p.settingsFile = std::filesystem::u8path(p.cmdLine.settingsFileName->getValue());
+                }
+                p.fileLogSystem = tl::file::FileLogSystem::create(_context, p.logFile);
 
-            _modelsInit();
-            _devicesInit();
-            _observersInit();
-            _inputFilesInit();
-            _windowsInit();
+                p.settings = ftk::Settings::create(
+                    _context,
+                    p.settingsFile,
+                    p.cmdLine.resetSettings->found());
+
+                std::filesystem::path probeCacheFile = p.settingsFile;
+                probeCacheFile.replace_extension(".probe.json");
+                p.probeCache = ProbeCache::create(_context, probeCacheFile);
+                if (p.cmdLine.resetSettings->found())
+                {
+                    p.probeCache->clear();
+                }
+            }
+            {
+                StartupProfilerScope scope(_context, "Models");
+                _modelsInit();
+            }
+            if (p.cmdLine.exportFileName->hasValue())
+            {
+                p.exportStatus =
+                    p.cmdLine.exportProcesses->hasValue() &&
+                    p.cmdLine.exportProcesses->getValue() > 1 &&
+                    !p.cmdLine.exportShard->hasValue() ?
+                    _exportCoordinate(p.cmdLine.exportProcesses->getValue()) :
+                    _exportRun();
+                return;
+            }
+            {
+                StartupProfilerScope scope(_context, "Devices");
+                _devicesInit();
+            }
+            {
+                StartupProfilerScope scope(_context, "Observers");
+                _observersInit();
+            }
+            {
+                StartupProfilerScope scope(_context, "Input files");
+                _inputFilesInit();
+            }
+            {
+                StartupProfilerScope scope(_context, "Windows");
+                _windowsInit();
+            }
 
             ftk::App::run();
         }
 
+        int App::getExportStatus() const
+        {
+            return _p->exportStatus;
+        }
+
         void App::_tick()
         {
             FTK_P();
+            _timelinesTick();
             if (auto player = p.player->get())
             {
                 player->tick();
             }
+            if (p.exportModel)
+            {
+                p.exportModel->tick();
+            }
+            if (p.statsModel)
+            {
+                p.statsModel->tick();
+            }
 #if defined(TLRENDER_BMD)
             if (p.bmdOutputDevice)
             {
@@ -685,6 +923,10 @@ namespace djv
             p.audioModel = AudioModel::create(_context, p.settings);
 
             p.toolsModel = ToolsModel::create(p.settings);
+
+            p.exportModel = ExportModel::create(_context);
+
+            p.statsModel = StatsModel::create(_context);
         }
 
         void App::_devicesInit()
@@ -704,12 +946,20 @@ namespace djv
 
             p.cacheObserver = ftk::ValueObserver<tl::timeline::PlayerCacheOptions>::create(
                 p.settingsModel->observeCache(),
-                [this](const tl::timeline::PlayerCacheOptions& value)
+                [this](const tl::timeline::PlayerCacheOptions&)
                 {
-                    if (auto player = _p->player->get())
-                    {
-                        player->setCacheOptions(value);
-                    }
+                    _playerCacheUpdate();
+                });
+
+            p.advancedObserver = ftk::ValueObserver<AdvancedSettings>::create(
+                p.settingsModel->observeAdvanced(),
+                [this](const AdvancedSettings& value)
+                {
+                    _p->probeCache->setEnabled(value.probeCache);
+                    _p->probeCache->setMax(value.probeCacheMB * 1024 * 1024);
+                    _playerPoolTrim();
+                    _standbyCheck();
+                    _playerCacheUpdate();
                 });
 
             p.filesObserver = ftk::ListObserver<std::shared_ptr<FilesModelItem> >::create(
@@ -922,32 +1172,35 @@ namespace djv
                         tl::file::Path(input),
                         tl::file::Path(audioFileName));
 
-                    if (auto player = p.player->get())
+                    // The timeline is loaded in the background, so store the
+                    // command line options with the file and apply them when
+                    // the player is created.
+                    if (auto item = p.filesModel->getA())
                     {
                         if (p.cmdLine.speed->hasValue())
                         {
-                            player->setSpeed(p.cmdLine.speed->getValue());
+                            item->speed = p.cmdLine.speed->getValue();
                         }
                         if (p.cmdLine.inOutRange->hasValue())
                         {
                             const OTIO_NS::TimeRange& inOutRange = p.cmdLine.inOutRange->getValue();
-                            player->setInOutRange(inOutRange);
-                            player->seek(inOutRange.start_time());
+                            item->inOutRange = inOutRange;
+                            item->currentTime = inOutRange.start_time();
                         }
                         if (p.cmdLine.seek->hasValue())
                         {
-                            player->seek(p.cmdLine.seek->getValue());
-                        }
-                        if (p.cmdLine.loop->hasValue())
-                        {
-                            player->setLoop(p.cmdLine.loop->getValue());
-                        }
-                        if (p.cmdLine.playback->hasValue())
-                        {
-                            player->setPlayback(p.cmdLine.playback->getValue());
+                            item->currentTime = p.cmdLine.seek->getValue();
                         }
                     }
                 }
+                if (p.cmdLine.loop->hasValue())
+                {
+                    p.cmdLineLoop = p.cmdLine.loop->getValue();
+                }
+                if (p.cmdLine.playback->hasValue())
+                {
+                    p.cmdLinePlayback = p.cmdLine.playback->getValue();
+                }
             }
         }
 
@@ -992,6 +1245,279 @@ namespace djv
         }
 
 
+        int App::_exportRun()
+        {
+            FTK_P();
+            int out = 1;
+            try
+            {
+                const auto& inputs = p.cmdLine.inputs->getList();
+                if (inputs.empty())
+                {
+                    throw std::runtime_error("No input to export");
+                }
+#if !defined(_WINDOWS) && !defined(__APPLE__)
+                // The OpenGL context is created with a hidden window, which
+                // needs an X11 or Wayland display. Check for one up front so
+                // that the export fails with a clear message.
+                const char* display = std::getenv("DISPLAY");
+                const char* waylandDisplay = std::getenv("WAYLAND_DISPLAY");
+                if ((!display || !display[0]) && (!waylandDisplay || !waylandDisplay[0]))
+                {
+                    throw std::runtime_error(
+                        "Exporting needs a display for the OpenGL context, but neither "
+                        "DISPLAY nor WAYLAND_DISPLAY is set. Run the export with a "
+                        "virtual display, for example: xvfb-run djv ...");
+                }
+#endif // _WINDOWS
+                auto timeline = tl::timeline::Timeline::create(
+                    _context,
+                    tl::file::Path(inputs.front()),
+                    _getTimelineOptions());
+
+                // Get the export settings from the output file name.
+                ExportSettings settings = p.settingsModel->getExport();
+                const tl::file::Path path(p.cmdLine.exportFileName->getValue());
+                settings.directory = path.getDirectory();
+                auto ioSystem = _context->getSystem<tl::io::WriteSystem>();
+                const auto movieExtensions = ioSystem->getExtensions(
+                    static_cast<int>(tl::io::FileType::Media));
+                const auto i = std::find(
+                    movieExtensions.begin(),
+                    movieExtensions.end(),
+                    ftk::toLower(path.getExtension()));
+                if (i != movieExtensions.end())
+                {
+                    settings.fileType = ExportFileType::Movie;
+                    settings.movieBaseName = path.getBaseName();
+                    settings.movieExtension = path.getExtension();
+                }
+                else
+                {
+                    settings.fileType = ExportFileType::Sequence;
+                    settings.imageBaseName = path.getBaseName();
+                    settings.imageZeroPad = path.getPadding();
+                    settings.imageExtension = path.getExtension();
+                }
+                ExportOptions options;
+                options.videoRequests = settings.videoRequests;
+                options.outputs.push_back(settings);
+
+                options.range = p.cmdLine.inOutRange->hasValue() ?
+                    p.cmdLine.inOutRange->getValue() :
+                    timeline->getTimeRange();
+                options.speed = p.cmdLine.speed->hasValue() ?
+                    p.cmdLine.speed->getValue() :
+                    timeline->getTimeRange().duration().rate();
+                options.ocioOptions = p.colorModel->getOCIOOptions();
+                options.lutOptions = p.colorModel->getLUTOptions();
+                options.imageOptions = p.viewportModel->getImageOptions();
+                options.displayOptions = p.viewportModel->getDisplayOptions();
+                options.colorBuffer = p.viewportModel->getColorBuffer();
+                if (p.cmdLine.exportShard->hasValue())
+                {
+                    options.shard = parseExportShard(p.cmdLine.exportShard->getValue());
+                }
+                options.shard.mode = p.cmdLine.exportShardMode->getValue();
+
+                // Create a hidden window for the OpenGL context.
+                std::shared_ptr<ftk::gl::Window> window;
+                try
+                {
+                    window = ftk::gl::Window::create(
+                        _context,
+                        "djv::app::App::export",
+                        ftk::Size2I(1, 1),
+                        static_cast<int>(ftk::gl::WindowOptions::MakeCurrent));
+                }
+                catch (const std::exception& e)
+                {
+                    throw std::runtime_error(ftk::Format(
+                        "Cannot create the OpenGL context for exporting: {0}").
+                        arg(e.what()));
+                }
+
+                // Run the export.
+                auto exporter = Exporter::create(_context, timeline, options);
+                const int64_t duration = exporter->getFrameTotal();
+                int64_t frameCount = -1;
+                while (!exporter->isFinished())
+                {
+                    exporter->tick();
+                    const int64_t count = exporter->getFrameCount();
+                    if (count != frameCount)
+                    {
+                        frameCount = count;
+                        std::cout << ftk::Format("Frame: {0} / {1}").
+                            arg(frameCount).
+                            arg(duration) << std::endl;
+                    }
+                    else
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                }
+                const std::string timings = getExportTimingsSummary(exporter->getTimings());
+                _context->log("djv::app::App", ftk::Format("Export timings:\n{0}").arg(timings));
+                std::cout << timings << std::endl;
+                exporter.reset();
+                out = 0;
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "ERROR: " << e.what() << std::endl;
+            }
+            return out;
+        }
+
+        int App::_exportCoordinate(int processes)
+        {
+            FTK_P();
+
+            // Get the worker arguments. The arguments are the same as this
+            // process, with a shard added. The settings and log files are
+            // replaced so that the workers do not write to the same files.
+            std::vector<std::string> args;
+            for (size_t i = 0; i < p.argv.size(); ++i)
+            {
+                if ("-exportProcesses" == p.argv[i] ||
+                    "-settingsFile" == p.argv[i] ||
+                    "-logFile" == p.argv[i])
+                {
+                    ++i;
+                }
+                else
+                {
+                    args.push_back(p.argv[i]);
+                }
+            }
+
+            // Each worker gets a copy of the settings and the probe cache in
+            // a temporary directory, which is removed when the export is
+            // finished.
+            std::error_code ec;
+            const std::filesystem::path tmpDir =
+                std::filesystem::temp_directory_path(ec) /
+                ftk::Format("djv.export.{0}").
+                    arg(std::chrono::steady_clock::now().time_since_epoch().count()).str();
+            std::filesystem::create_directories(tmpDir, ec);
+            if (ec)
+            {
+                std::cerr << "ERROR: Cannot create the directory: " << tmpDir.u8string() << std::endl;
+                return 1;
+            }
+            std::filesystem::path probeCacheFile = p.settingsFile;
+            probeCacheFile.replace_extension(".probe.json");
+
+            // Start the workers.
+            struct Worker
+            {
+                std::shared_ptr<Process> process;
+                std::atomic<int64_t> frame;
+                std::atomic<int64_t> frameTotal;
+                std::atomic<bool> done;
+                std::thread thread;
+            };
+            std::vector<std::unique_ptr<Worker> > workers;
+            for (int i = 0; i < processes; ++i)
+            {
+                const std::filesystem::path workerSettings =
+                    tmpDir / ftk::Format("settings.{0}.json").arg(i + 1).str();
+                std::filesystem::path workerProbeCache = workerSettings;
+                workerProbeCache.replace_extension(".probe.json");
+                std::filesystem::copy_file(p.settingsFile, workerSettings, ec);
+                std::filesystem::copy_file(probeCacheFile, workerProbeCache, ec);
+                std::vector<std::string> workerArgs = args;
+                workerArgs.push_back("-exportShard");
+                workerArgs.push_back(ftk::Format("{0}/{1}").arg(i + 1).arg(processes));
+                workerArgs.push_back("-settingsFile");
+                workerArgs.push_back(workerSettings.u8string());
+                workerArgs.push_back("-logFile");
+                workerArgs.push_back((tmpDir / ftk::Format("log.{0}.txt").arg(i + 1).str()).u8string());
+                std::shared_ptr<Process> process;
+                try
+                {
+                    process = Process::create(workerArgs);
+                }
+                catch (const std::exception& e)
+                {
+                    std::cerr << "ERROR: " << e.what() << std::endl;
+                    continue;
+                }
+                auto worker = std::make_unique<Worker>();
+                worker->process = process;
+                worker->frame = 0;
+                worker->frameTotal = 0;
+                worker->done = false;
+                Worker* workerP = worker.get();
+                worker->thread = std::thread(
+                    [workerP]
+                    {
+                        std::string line;
+                        while (workerP->process->readLine(line))
+                        {
+                            long long frame = 0;
+                            long long frameTotal = 0;
+                            if (2 == sscanf(line.c_str(), "Frame: %lld / %lld", &frame, &frameTotal))
+                            {
+                                workerP->frame = frame;
+                                workerP->frameTotal = frameTotal;
+                            }
+                        }
+                        workerP->done = true;
+                    });
+                workers.push_back(std::move(worker));
+            }
+
+            // Merge the progress of the workers.
+            int64_t frame = -1;
+            while (true)
+            {
+                bool done = true;
+                int64_t workersFrame = 0;
+                int64_t workersFrameTotal = 0;
+                for (const auto& worker : workers)
+                {
+                    workersFrame += worker->frame;
+                    workersFrameTotal += worker->frameTotal;
+                    done &= worker->done;
+                }
+                if (workersFrame != frame)
+                {
+                    frame = workersFrame;
+                    std::cout << ftk::Format("Frame: {0} / {1}").
+                        arg(workersFrame).
+                        arg(workersFrameTotal) << std::endl;
+                }
+                if (done)
+                {
+                    break;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            }
+
+            // Wait for the workers to finish. The worker logs are kept if
+            // the export fails.
+            int out = workers.size() == static_cast<size_t>(processes) ? 0 : 1;
+            for (auto& worker : workers)
+            {
+                worker->thread.join();
+                if (worker->process->wait() != 0)
+                {
+                    out = 1;
+                }
+            }
+            if (0 == out)
+            {
+                std::filesystem::remove_all(tmpDir, ec);
+            }
+            else
+            {
+                std::cerr << "ERROR: The worker logs are in: " << tmpDir.u8string() << std::endl;
+            }
+            return out;
+        }
+
         std::filesystem::path App::_appDocsPath()
         {
             const std::filesystem::path documentsPath = ftk::getUserPath(ftk::UserPath::Documents);
@@ -1041,55 +1567,426 @@ namespace djv
             return out;
         }
 
+        tl::timeline::Options App::_getTimelineOptions() const
+        {
+            FTK_P();
+            tl::timeline::Options out;
+            const ImageSequenceSettings imageSequence = p.settingsModel->getImageSequence();
+            out.imageSequenceAudio = imageSequence.audio;
+            out.imageSequenceAudioExtensions = imageSequence.audioExtensions;
+            out.imageSequenceAudioFileName = imageSequence.audioFileName;
+            const AdvancedSettings advanced = p.settingsModel->getAdvanced();
+            out.compat = advanced.compat;
+            out.videoRequestMax = advanced.videoRequestMax;
+            out.audioRequestMax = advanced.audioRequestMax;
+            out.ioOptions = _getIOOptions();
+            out.pathOptions.maxNumberDigits = imageSequence.maxDigits;
+            return out;
+        }
+
+        std::string App::_getProbeKey(
+            const tl::file::Path& path,
+            const tl::file::Path& audioPath,
+            const tl::timeline::Options& options) const
+        {
+            // The key uses absolute canonical paths, so that the same file
+            // opened with different relative paths shares an entry. The key
+            // also includes the options that change how the timeline is
+            // created.
+            std::stringstream ss;
+            ss << getCanonicalPath(path) << "|";
+            if (!audioPath.isEmpty())
+            {
+                ss << getCanonicalPath(audioPath);
+            }
+            ss << "|" << static_cast<int>(options.imageSequenceAudio);
+            for (const auto& i : options.imageSequenceAudioExtensions)
+            {
+                ss << "|" << i;
+            }
+            ss << "|" << options.imageSequenceAudioFileName;
+            ss << "|" << options.compat;
+            ss << "|" << options.pathOptions.maxNumberDigits;
+            for (const auto& i : options.ioOptions)
+            {
+                ss << "|" << i.first << "=" << i.second;
+            }
+            return ss.str();
+        }
+
+        int App::_getFileIndex(const std::shared_ptr<FilesModelItem>& item) const
+        {
+            FTK_P();
+            const auto i = p.filesIndexes.find(item);
+            return i != p.filesIndexes.end() ? static_cast<int>(i->second) : -1;
+        }
+
+        std::shared_ptr<tl::timeline::Timeline> App::_getTimeline(const std::shared_ptr<FilesModelItem>& item) const
+        {
+            FTK_P();
+            const int index = _getFileIndex(item);
+            return index != -1 ? p.timelines[index] : nullptr;
+        }
+
+        std::shared_ptr<tl::timeline::Player> App::_createPlayer(
+            const std::shared_ptr<tl::timeline::Timeline>& timeline,
+            const tl::timeline::PlayerCacheOptions& cache,
+            const tl::audio::DeviceID& audioDevice)
+        {
+            FTK_P();
+            tl::timeline::PlayerOptions playerOptions;
+            playerOptions.audioDevice = audioDevice;
+            playerOptions.cache = cache;
+            const AdvancedSettings advanced = p.settingsModel->getAdvanced();
+            playerOptions.videoRequestMax = advanced.videoRequestMax;
+            playerOptions.audioRequestMax = advanced.audioRequestMax;
+            playerOptions.audioBufferFrameCount = advanced.audioBufferFrameCount;
+            return tl::timeline::Player::create(_context, timeline, playerOptions);
+        }
+
         void App::_filesUpdate(const std::vector<std::shared_ptr<FilesModelItem> >& files)
         {
             FTK_P();
 
+            std::unordered_map<std::shared_ptr<FilesModelItem>, size_t> filesIndexes;
+            filesIndexes.reserve(files.size());
             std::vector<std::shared_ptr<tl::timeline::Timeline> > timelines(files.size());
             for (size_t i = 0; i < files.size(); ++i)
             {
-                const auto j = std::find(p.files.begin(), p.files.end(), files[i]);
-                if (j != p.files.end())
+                filesIndexes[files[i]] = i;
+                const int j = _getFileIndex(files[i]);
+                if (j != -1)
                 {
-                    timelines[i] = p.timelines[j - p.files.begin()];
+                    timelines[i] = p.timelines[j];
                 }
             }
 
-            for (size_t i = 0; i < files.size(); ++i)
+            // Remove queued files that have been closed. Files that are
+            // already loading are discarded when they finish.
+            auto i = p.timelineQueue.begin();
+            while (i != p.timelineQueue.end())
             {
-                if (!timelines[i])
+                if (filesIndexes.find(*i) == filesIndexes.end())
                 {
-                    try
+                    p.timelinesPending.erase(*i);
+                    i = p.timelineQueue.erase(i);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+            auto j = p.timelinesInactive.begin();
+            while (j != p.timelinesInactive.end())
+            {
+                if (filesIndexes.find(j->first) == filesIndexes.end())
+                {
+                    j = p.timelinesInactive.erase(j);
+                }
+                else
+                {
+                    ++j;
+                }
+            }
+
+            auto k = p.playerPool.begin();
+            while (k != p.playerPool.end())
+            {
+                if (filesIndexes.find(k->item) == filesIndexes.end())
+                {
+                    k = p.playerPool.erase(k);
+                }
+                else
+                {
+                    ++k;
+                }
+            }
+
+            p.files = files;
+            p.filesIndexes = std::move(filesIndexes);
+            p.timelines = timelines;
+
+            _standbyCheck();
+            _playerCacheUpdate();
+        }
+
+        void App::_timelinesQueue(
+            const std::vector<std::shared_ptr<FilesModelItem> >& activeFiles,
+            const std::shared_ptr<FilesModelItem>& standby)
+        {
+            FTK_P();
+
+            // Timelines are only loaded for the active files and the
+            // standby file. Files that are no longer active are unloaded
+            // after a timeout, unless they are kept in the player pool.
+            std::vector<std::shared_ptr<FilesModelItem> > wanted = activeFiles;
+            if (standby)
+            {
+                wanted.push_back(standby);
+            }
+            const std::set<std::shared_ptr<FilesModelItem> > activeSet(wanted.begin(), wanted.end());
+            const auto now = std::chrono::steady_clock::now();
+            for (const auto& item : p.timelinesWanted)
+            {
+                const int index = _getFileIndex(item);
+                if (index != -1 &&
+                    p.timelines[index] &&
+                    activeSet.find(item) == activeSet.end() &&
+                    !_isPlayerPooled(item))
+                {
+                    p.timelinesInactive[item] = now;
+                }
+            }
+            auto i = p.timelineQueue.begin();
+            while (i != p.timelineQueue.end())
+            {
+                if (activeSet.find(*i) == activeSet.end())
+                {
+                    (*i)->load->setIfChanged(FilesModelLoadState());
+                    p.timelinesPending.erase(*i);
+                    i = p.timelineQueue.erase(i);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+
+            // Queue the active files for loading. Files that failed to
+            // load are not queued again until they are reloaded.
+            for (const auto& item : wanted)
+            {
+                p.timelinesInactive.erase(item);
+                const int index = _getFileIndex(item);
+                if (index != -1 &&
+                    !p.timelines[index] &&
+                    item->load->get().status != FilesModelLoad::Error &&
+                    p.timelinesPending.find(item) == p.timelinesPending.end())
+                {
+                    FilesModelLoadState state;
+                    state.status = FilesModelLoad::Queued;
+                    item->load->setIfChanged(state);
+                    p.timelineQueue.push_back(item);
+                    p.timelinesPending.insert(item);
+                }
+            }
+            p.timelinesWanted = wanted;
+
+            _timelinesLoad();
+        }
+
+        void App::_timelinesLoad()
+        {
+            FTK_P();
+            while (!p.timelineQueue.empty() && p.timelineLoads.size() < p.timelineLoadMax)
+            {
+                const auto item = p.timelineQueue.front();
+                p.timelineQueue.pop_front();
+                const tl::file::Path path = item->path;
+                const tl::file::Path audioPath = item->audioPath;
+                tl::timeline::Options options = _getTimelineOptions();
+                for (const auto& i : getGenerationOptions(*item))
+                {
+                    options.ioOptions[i.first] = i.second;
+                }
+                std::shared_ptr<ftk::Context> context = _context;
+                Private::TimelineLoad load;
+                load.item = item;
+                load.stage = std::make_shared<std::atomic<FilesModelLoadStage> >(FilesModelLoadStage::None);
+                load.stamps = std::make_shared<std::vector<FileStamp> >();
+                load.stampsValid = std::make_shared<bool>(false);
+                auto stage = load.stage;
+                auto stamps = load.stamps;
+                auto stampsValid = load.stampsValid;
+
+                // OTIO files are not stored in the probe cache since they do
+                // not need to be probed.
+                std::shared_ptr<ProbeCache> probeCache;
+                std::string probeKey;
+                const std::string extension = ftk::toLower(path.getExtension());
+                if (extension != ".otio" && extension != ".otioz")
+                {
+                    probeCache = p.probeCache;
+                    probeKey = _getProbeKey(path, audioPath, options);
+                }
+
+                load.future = std::async(
+                    std::launch::async,
+                    [context, path, audioPath, options, stage, stamps, stampsValid, probeCache, probeKey]
                     {
-                        tl::timeline::Options options;
-                        const ImageSequenceSettings imageSequence = p.settingsModel->getImageSequence();
-                        options.imageSequenceAudio = imageSequence.audio;
-                        options.imageSequenceAudioExtensions = imageSequence.audioExtensions;
-                        options.imageSequenceAudioFileName = imageSequence.audioFileName;
-                        const AdvancedSettings advanced = p.settingsModel->getAdvanced();
-                        options.compat = advanced.compat;
-                        options.videoRequestMax = advanced.videoRequestMax;
-                        options.audioRequestMax = advanced.audioRequestMax;
-                        options.ioOptions = _getIOOptions();
-                        options.pathOptions.maxNumberDigits = imageSequence.maxDigits;
-                        auto otioTimeline = files[i]->audioPath.isEmpty() ?
-                            tl::timeline::create(_context, files[i]->path, options) :
-                            tl::timeline::create(_context, files[i]->path, files[i]->audioPath, options);
-                        timelines[i] = tl::timeline::Timeline::create(_context, otioTimeline, options);
-                        for (const auto& video : timelines[i]->getIOInfo().video)
+                        // The probe cache is checked with a single stat of
+                        // the file or sequence directory.
+                        std::vector<FileStamp> probeStamps;
+                        OTIO_NS::SerializableObject::Retainer<OTIO_NS::Timeline> otioTimeline;
+                        if (probeCache)
                         {
-                            files[i]->videoLayers.push_back(video.name);
+                            *stage = FilesModelLoadStage::ProbeCache;
+                            probeStamps.push_back(getProbeStamp(path));
+                            if (!audioPath.isEmpty())
+                            {
+                                probeStamps.push_back(getProbeStamp(audioPath));
+                            }
+                            otioTimeline = probeCache->get(probeKey, probeStamps);
+                        }
+                        if (!otioTimeline)
+                        {
+                            // Get the stamps before probing, so changes made
+                            // while loading are found on the next reload. On
+                            // a cache hit the stamps are taken after loading
+                            // instead, so the sequence directory is not
+                            // listed before the file is shown.
+                            *stage = FilesModelLoadStage::Stamps;
+                            *stamps = getFileStamps(path);
+                            if (!audioPath.isEmpty())
+                            {
+                                const auto audioStamps = getFileStamps(audioPath);
+                                stamps->insert(stamps->end(), audioStamps.begin(), audioStamps.end());
+                            }
+                            *stampsValid = true;
+
+                            *stage = FilesModelLoadStage::Probe;
+                            otioTimeline = audioPath.isEmpty() ?
+                                tl::timeline::create(context, path, options) :
+                                tl::timeline::create(context, path, audioPath, options);
+                            if (probeCache)
+                            {
+                                probeCache->add(probeKey, probeStamps, otioTimeline);
+                            }
                         }
+                        *stage = FilesModelLoadStage::Timeline;
+                        return tl::timeline::Timeline::create(context, otioTimeline, options);
+                    });
+                FilesModelLoadState state;
+                state.status = FilesModelLoad::Loading;
+                item->load->setIfChanged(state);
+                p.timelineLoads.push_back(std::move(load));
+            }
+        }
+
+        void App::_timelinesTick()
+        {
+            FTK_P();
+            const auto now = std::chrono::steady_clock::now();
+            bool activeUpdate = false;
+            bool standbyUpdate = false;
+            auto i = p.timelineLoads.begin();
+            while (i != p.timelineLoads.end())
+            {
+                if (i->future.valid() &&
+                    i->future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                {
+                    FilesModelLoadState state;
+                    std::shared_ptr<tl::timeline::Timeline> timeline;
+                    try
+                    {
+                        timeline = i->future.get();
+                        state.status = FilesModelLoad::Ready;
                     }
                     catch (const std::exception& e)
                     {
+                        state.status = FilesModelLoad::Error;
+                        state.error = e.what();
                         _context->log("djv::app::App", e.what(), ftk::LogType::Error);
                     }
+                    const int j = _getFileIndex(i->item);
+                    if (timeline && j != -1)
+                    {
+                        p.timelines[j] = timeline;
+                        i->item->ioInfo = timeline->getIOInfo();
+                        if (*i->stampsValid)
+                        {
+                            i->item->stamps = *i->stamps;
+                        }
+                        else
+                        {
+                            _stampsLoad(i->item);
+                        }
+                        i->item->videoLayers.clear();
+                        for (const auto& video : timeline->getIOInfo().video)
+                        {
+                            i->item->videoLayers.push_back(video.name);
+                        }
+                        const auto k = std::find(p.activeFiles.begin(), p.activeFiles.end(), i->item);
+                        if (k != p.activeFiles.end())
+                        {
+                            activeUpdate = true;
+                        }
+                        else if (i->item == p.standby.item)
+                        {
+                            standbyUpdate = true;
+                        }
+                        else
+                        {
+                            p.timelinesInactive[i->item] = now;
+                        }
+                    }
+                    p.timelinesPending.erase(i->item);
+                    i->item->load->setIfChanged(state);
+                    i = p.timelineLoads.erase(i);
+                }
+                else
+                {
+                    FilesModelLoadState state = i->item->load->get();
+                    state.stage = *i->stage;
+                    i->item->load->setIfChanged(state);
+                    ++i;
                 }
             }
 
-            p.files = files;
-            p.timelines = timelines;
+            // Get the stamps that were deferred by probe cache hits.
+            auto k = p.stampsLoads.begin();
+            while (k != p.stampsLoads.end())
+            {
+                if (k->future.valid() &&
+                    k->future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                {
+                    auto stamps = k->future.get();
+                    if (k->item->generation == k->generation)
+                    {
+                        k->item->stamps = std::move(stamps);
+                    }
+                    k = p.stampsLoads.erase(k);
+                }
+                else
+                {
+                    ++k;
+                }
+            }
+
+            // Unload the timelines that have been inactive for too long.
+            const size_t unloadTimeout = p.settingsModel->getAdvanced().timelineUnloadTimeout;
+            if (unloadTimeout > 0)
+            {
+                auto j = p.timelinesInactive.begin();
+                while (j != p.timelinesInactive.end())
+                {
+                    if (now - j->second > std::chrono::seconds(unloadTimeout))
+                    {
+                        const int index = _getFileIndex(j->first);
+                        if (index != -1)
+                        {
+                            p.timelines[index].reset();
+                        }
+                        j->first->load->setIfChanged(FilesModelLoadState());
+                        j = p.timelinesInactive.erase(j);
+                    }
+                    else
+                    {
+                        ++j;
+                    }
+                }
+            }
+
+            _timelinesLoad();
+            if (activeUpdate)
+            {
+                _activeUpdate(p.activeFiles);
+            }
+            else if (standbyUpdate)
+            {
+                _standbyUpdate(p.standby.item);
+                _playerCacheUpdate();
+            }
         }
 
         void App::_activeUpdate(const std::vector<std::shared_ptr<FilesModelItem> >& activeFiles)
@@ -1106,10 +2003,15 @@ namespace djv
                 }
             }
 
+            const auto standby = _getStandbyFile(activeFiles);
+            _timelinesQueue(activeFiles, standby);
+
             std::shared_ptr<tl::timeline::Player> player;
             if (!activeFiles.empty())
             {
-                if (!p.activeFiles.empty() && activeFiles[0] == p.activeFiles[0])
+                if (!p.activeFiles.empty() &&
+                    activeFiles[0] == p.activeFiles[0] &&
+                    p.player->get())
                 {
                     player = p.player->get();
                 }
@@ -1118,28 +2020,47 @@ namespace djv
                     if (auto player = p.player->get())
                     {
                         player->setAudioDevice(tl::audio::DeviceID());
+                        if (!p.activeFiles.empty())
+                        {
+                            _playerPoolAdd(p.activeFiles[0], player);
+                        }
+                    }
+                    if (auto pooled = _playerPoolTake(activeFiles[0]))
+                    {
+                        // Use the pooled player and its cache.
+                        player = pooled;
+                        player->setAudioDevice(p.audioModel->getDevice());
+                    }
+                    else if (activeFiles[0] == p.standby.item && p.standby.player)
+                    {
+                        // Use the standby player, restoring the audio device.
+                        player = p.standby.player;
+                        p.standby.player.reset();
+                        player->setAudioDevice(p.audioModel->getDevice());
                     }
-                    auto i = std::find(p.files.begin(), p.files.end(), activeFiles[0]);
-                    if (i != p.files.end())
+                    else if (auto timeline = _getTimeline(activeFiles[0]))
                     {
-                        if (auto timeline = p.timelines[i - p.files.begin()])
+                        try
                         {
-                            try
+                            player = _createPlayer(
+                                timeline,
+                                p.settingsModel->getCache(),
+                                p.audioModel->getDevice());
+                            if (p.cmdLineLoop.has_value())
                             {
-                                tl::timeline::PlayerOptions playerOptions;
-                                playerOptions.audioDevice = p.audioModel->getDevice();
-                                playerOptions.cache = p.settingsModel->getCache();
-                                const AdvancedSettings advanced = p.settingsModel->getAdvanced();
-                                playerOptions.videoRequestMax = advanced.videoRequestMax;
-                                playerOptions.audioRequestMax = advanced.audioRequestMax;
-                                playerOptions.audioBufferFrameCount = advanced.audioBufferFrameCount;
-                                player = tl::timeline::Player::create(_context, timeline, playerOptions);
+                                player->setLoop(p.cmdLineLoop.value());
+                                p.cmdLineLoop.reset();
                             }
-                            catch (const std::exception& e)
+                            if (p.cmdLinePlayback.has_value())
                             {
-                                _context->log("djv::app::App", e.what(), ftk::LogType::Error);
+                                player->setPlayback(p.cmdLinePlayback.value());
+                                p.cmdLinePlayback.reset();
                             }
                         }
+                        catch (const std::exception& e)
+                        {
+                            _context->log("djv::app::App", e.what(), ftk::LogType::Error);
+                        }
                     }
                 }
             }
@@ -1163,11 +2084,13 @@ namespace djv
                 std::vector<std::shared_ptr<tl::timeline::Timeline> > compare;
                 for (size_t i = 1; i < activeFiles.size(); ++i)
                 {
-                    auto j = std::find(p.files.begin(), p.files.end(), activeFiles[i]);
-                    if (j != p.files.end())
+                    const int j = _getFileIndex(activeFiles[i]);
+                    if (j != -1)
                     {
-                        auto timeline = p.timelines[j - p.files.begin()];
-                        compare.push_back(timeline);
+                        if (auto timeline = p.timelines[j])
+                        {
+                            compare.push_back(timeline);
+                        }
                     }
                 }
                 player->setCompare(compare);
@@ -1182,6 +2105,285 @@ namespace djv
 
             _layersUpdate(p.filesModel->observeLayers()->get());
             _audioUpdate();
+            _standbyUpdate(standby);
+            _playerCacheUpdate();
+        }
+
+        std::shared_ptr<FilesModelItem> App::_getStandbyFile(
+            const std::vector<std::shared_ptr<FilesModelItem> >& activeFiles) const
+        {
+            FTK_P();
+            std::shared_ptr<FilesModelItem> out;
+            if (p.settingsModel->getAdvanced().standbyPlayer &&
+                !activeFiles.empty() &&
+                p.files.size() > 1)
+            {
+                const int index = _getFileIndex(activeFiles[0]);
+                if (index != -1)
+                {
+                    out = p.files[(index + 1) % p.files.size()];
+                    const auto i = std::find(activeFiles.begin(), activeFiles.end(), out);
+                    if (i != activeFiles.end())
+                    {
+                        out.reset();
+                    }
+                }
+            }
+            return out;
+        }
+
+        void App::_standbyCheck()
+        {
+            FTK_P();
+            const auto standby = _getStandbyFile(p.activeFiles);
+            if (standby != p.standby.item)
+            {
+                _timelinesQueue(p.activeFiles, standby);
+                _standbyUpdate(standby);
+                _playerCacheUpdate();
+            }
+        }
+
+        void App::_standbyUpdate(const std::shared_ptr<FilesModelItem>& item)
+        {
+            FTK_P();
+            if (item != p.standby.item)
+            {
+                p.standby.item = item;
+                p.standby.player.reset();
+            }
+            if (item && !p.standby.player && !_isPlayerPooled(item))
+            {
+                if (auto timeline = _getTimeline(item))
+                {
+                    try
+                    {
+                        // The standby player only uses a small part of the
+                        // cache, around the saved time of the file.
+                        const AdvancedSettings advanced = p.settingsModel->getAdvanced();
+                        tl::timeline::PlayerCacheOptions cache = p.settingsModel->getCache();
+                        cache.videoGB = std::min(cache.videoGB, advanced.standbyCacheGB);
+                        cache.audioGB = std::min(cache.audioGB, advanced.standbyCacheGB);
+                        auto player = _createPlayer(timeline, cache, tl::audio::DeviceID());
+                        if (item->speed >= 0.0)
+                        {
+                            player->setSpeed(item->speed);
+                        }
+                        if (!tl::time::compareExact(item->inOutRange, tl::time::invalidTimeRange))
+                        {
+                            player->setInOutRange(item->inOutRange);
+                        }
+                        if (!item->currentTime.strictly_equal(tl::time::invalidTime))
+                        {
+                            player->seek(item->currentTime);
+                        }
+                        player->setVideoLayer(item->videoLayer);
+                        p.standby.player = player;
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _context->log("djv::app::App", e.what(), ftk::LogType::Error);
+                    }
+                }
+            }
+        }
+
+        void App::_stampsLoad(const std::shared_ptr<FilesModelItem>& item)
+        {
+            FTK_P();
+            const tl::file::Path path = item->path;
+            const tl::file::Path audioPath = item->audioPath;
+            Private::StampsLoad load;
+            load.item = item;
+            load.generation = item->generation;
+            load.future = std::async(
+                std::launch::async,
+                [path, audioPath]
+                {
+                    auto out = getFileStamps(path);
+                    if (!audioPath.isEmpty())
+                    {
+                        const auto audioStamps = getFileStamps(audioPath);
+                        out.insert(out.end(), audioStamps.begin(), audioStamps.end());
+                    }
+                    return out;
+                });
+            p.stampsLoads.push_back(std::move(load));
+        }
+
+        bool App::_reloadCheck(const std::shared_ptr<FilesModelItem>& item)
+        {
+            FTK_P();
+            for (const auto& load : p.stampsLoads)
+            {
+                if (load.item == item)
+                {
+                    // The file was loaded from the probe cache and the
+                    // stamps are not ready yet.
+                    return false;
+                }
+            }
+            auto stamps = getFileStamps(item->path);
+            if (!item->audioPath.isEmpty())
+            {
+                const auto audioStamps = getFileStamps(item->audioPath);
+                stamps.insert(stamps.end(), audioStamps.begin(), audioStamps.end());
+            }
+            size_t changedCount = 0;
+            for (size_t j = 0; j < stamps.size(); ++j)
+            {
+                if (j >= item->stamps.size() || stamps[j] != item->stamps[j])
+                {
+                    ++changedCount;
+                }
+            }
+            const bool out = changedCount > 0 || stamps.size() != item->stamps.size();
+            if (out)
+            {
+                _context->log(
+                    "djv::app::App",
+                    ftk::Format("Reloading {0}: {1} of {2} files changed").
+                        arg(item->path.get()).
+                        arg(changedCount).
+                        arg(stamps.size()));
+                ++item->generation;
+            }
+            return out;
+        }
+
+        void App::_reloadReset(const std::shared_ptr<FilesModelItem>& item)
+        {
+            FTK_P();
+            const int index = _getFileIndex(item);
+            if (index != -1)
+            {
+                p.timelines[index].reset();
+            }
+            p.timelinesInactive.erase(item);
+            item->load->setIfChanged(FilesModelLoadState());
+        }
+
+        bool App::_isPlayerPooled(const std::shared_ptr<FilesModelItem>& item) const
+        {
+            FTK_P();
+            for (const auto& i : p.playerPool)
+            {
+                if (i.item == item)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void App::_playerPoolAdd(
+            const std::shared_ptr<FilesModelItem>& item,
+            const std::shared_ptr<tl::timeline::Player>& player)
+        {
+            FTK_P();
+            if (_getFileIndex(item) != -1 &&
+                p.settingsModel->getAdvanced().playerPoolSize > 0)
+            {
+                player->setPlayback(tl::timeline::Playback::Stop);
+
+                // The pooled player is charged for the cache it holds, not
+                // the cache it was given.
+                tl::timeline::PlayerCacheOptions cache = player->getCacheOptions();
+                const tl::timeline::PlayerCacheInfo info = player->observeCacheInfo()->get();
+                cache.videoGB *= info.videoPercentage / 100.F;
+                cache.audioGB *= info.audioPercentage / 100.F;
+                p.playerPool.push_front({ item, player, cache });
+                p.timelinesInactive.erase(item);
+                _playerPoolTrim();
+            }
+        }
+
+        std::shared_ptr<tl::timeline::Player> App::_playerPoolTake(const std::shared_ptr<FilesModelItem>& item)
+        {
+            FTK_P();
+            std::shared_ptr<tl::timeline::Player> out;
+            for (auto i = p.playerPool.begin(); i != p.playerPool.end(); ++i)
+            {
+                if (i->item == item)
+                {
+                    out = i->player;
+                    p.playerPool.erase(i);
+                    break;
+                }
+            }
+            return out;
+        }
+
+        void App::_playerPoolTrim()
+        {
+            FTK_P();
+            const size_t size = p.settingsModel->getAdvanced().playerPoolSize;
+            while (p.playerPool.size() > size)
+            {
+                _playerPoolRemove();
+            }
+        }
+
+        void App::_playerPoolRemove()
+        {
+            FTK_P();
+            // Files removed from the pool are unloaded after the timeout
+            // like other inactive files.
+            const auto item = p.playerPool.back().item;
+            p.playerPool.pop_back();
+            if (_getTimeline(item) &&
+                std::find(p.timelinesWanted.begin(), p.timelinesWanted.end(), item) == p.timelinesWanted.end())
+            {
+                p.timelinesInactive[item] = std::chrono::steady_clock::now();
+            }
+        }
+
+        void App::_playerCacheUpdate()
+        {
+            FTK_P();
+
+            // The cache settings are one budget shared by the current
+            // player, the standby player, and the pooled players. The pooled
+            // players share up to half of what remains after the standby
+            // player, the most recent first. Each keeps the cache it holds
+            // if it fits, otherwise its cache is reduced, and players left
+            // without a share are released.
+            const tl::timeline::PlayerCacheOptions cache = p.settingsModel->getCache();
+            tl::timeline::PlayerCacheOptions activeCache = cache;
+            if (p.standby.player)
+            {
+                const float standbyGB = p.settingsModel->getAdvanced().standbyCacheGB;
+                tl::timeline::PlayerCacheOptions standbyCache = cache;
+                standbyCache.videoGB = std::min(cache.videoGB, standbyGB);
+                standbyCache.audioGB = std::min(cache.audioGB, standbyGB);
+                p.standby.player->setCacheOptions(standbyCache);
+                activeCache.videoGB -= standbyCache.videoGB;
+                activeCache.audioGB -= standbyCache.audioGB;
+            }
+            float poolVideoGB = activeCache.videoGB / 2.F;
+            float poolAudioGB = activeCache.audioGB / 2.F;
+            size_t count = 0;
+            for (auto& i : p.playerPool)
+            {
+                if (poolVideoGB <= 0.F && poolAudioGB <= 0.F)
+                    break;
+                i.cache.videoGB = std::min(i.cache.videoGB, poolVideoGB);
+                i.cache.audioGB = std::min(i.cache.audioGB, poolAudioGB);
+                i.player->setCacheOptions(i.cache);
+                poolVideoGB -= i.cache.videoGB;
+                poolAudioGB -= i.cache.audioGB;
+                activeCache.videoGB -= i.cache.videoGB;
+                activeCache.audioGB -= i.cache.audioGB;
+                ++count;
+            }
+            while (p.playerPool.size() > count)
+            {
+                _playerPoolRemove();
+            }
+            if (auto player = p.player->get())
+            {
+                player->setCacheOptions(activeCache);
+            }
         }
 
         void App::_layersUpdate(const std::vector<int>& value)
@@ -1193,17 +2395,17 @@ namespace djv
                 std::vector<int> compareVideoLayers;
                 if (!value.empty() && value.size() == p.files.size() && !p.activeFiles.empty())
                 {
-                    auto i = std::find(p.files.begin(), p.files.end(), p.activeFiles.front());
-                    if (i != p.files.end())
+                    int i = _getFileIndex(p.activeFiles.front());
+                    if (i != -1)
                     {
-                        videoLayer = value[i - p.files.begin()];
+                        videoLayer = value[i];
                     }
                     for (size_t j = 1; j < p.activeFiles.size(); ++j)
                     {
-                        i = std::find(p.files.begin(), p.files.end(), p.activeFiles[j]);
-                        if (i != p.files.end())
+                        i = _getFileIndex(p.activeFiles[j]);
+                        if (i != -1 && p.timelines[i])
                         {
-                            compareVideoLayers.push_back(value[i - p.files.begin()]);
+                            compareVideoLayers.push_back(value[i]);
                         }
                     }
                 }
@@ -33,10 +33,12 @@ namespace djv
 
         class AudioModel;
         class ColorModel;
+        class ExportModel;
         class FilesModel;
         class MainWindow;
         class RecentFilesModel;
         class SettingsModel;
+        class StatsModel;
         class TimeUnitsModel;
         class ToolsModel;
         class ViewportModel;
@@ -90,7 +92,7 @@ namespace djv
             //! Get the recent files model.
             const std::shared_ptr<RecentFilesModel>& getRecentFilesModel() const;
 
-            //! Reload the active files.
+            //! Reload the active files that have changed on disk.
             void reload();
 
             //! Observe the timeline player.
@@ -108,6 +110,12 @@ namespace djv
             //! Get the tools model.
             const std::shared_ptr<ToolsModel>& getToolsModel() const;
 
+            //! Get the export model.
+            const std::shared_ptr<ExportModel>& getExportModel() const;
+
+            //! Get the statistics model.
+            const std::shared_ptr<StatsModel>& getStatsModel() const;
+
             //! Get the main window.
             const std::shared_ptr<MainWindow>& getMainWindow() const;
 
@@ -127,6 +135,9 @@ namespace djv
 
             void run() override;
 
+            //! Get the exit status of the command line export.
+            int getExportStatus() const;
+
         protected:
             void _tick() override;
 
@@ -136,6 +147,8 @@ namespace djv
             void _observersInit();
             void _inputFilesInit();
             void _windowsInit();
+            int _exportRun();
+            int _exportCoordinate(int processes);
 
             std::filesystem::path _appDocsPath();
             std::filesystem::path _getLogFilePath(
@@ -145,9 +158,40 @@ namespace djv
                 const std::string& appName,
                 const std::filesystem::path& appDocsPath);
             tl::io::Options _getIOOptions() const;
+            tl::timeline::Options _getTimelineOptions() const;
+            std::string _getProbeKey(
+                const tl::file::Path&,
+                const tl::file::Path& audioPath,
+                const tl::timeline::Options&) const;
+            int _getFileIndex(const std::shared_ptr<FilesModelItem>&) const;
+            std::shared_ptr<tl::timeline::Timeline> _getTimeline(const std::shared_ptr<FilesModelItem>&) const;
+            std::shared_ptr<tl::timeline::Player> _createPlayer(
+                const std::shared_ptr<tl::timeline::Timeline>&,
+                const tl::timeline::PlayerCacheOptions&,
+                const tl::audio::DeviceID&);
 
             void _filesUpdate(const std::vector<std::shared_ptr<FilesModelItem> >&);
+            void _timelinesQueue(
+                const std::vector<std::shared_ptr<FilesModelItem> >&,
+                const std::shared_ptr<FilesModelItem>& standby);
+            void _timelinesLoad();
+            void _timelinesTick();
             void _activeUpdate(const std::vector<std::shared_ptr<FilesModelItem> >&);
+            std::shared_ptr<FilesModelItem> _getStandbyFile(
+                const std::vector<std::shared_ptr<FilesModelItem> >&) const;
+            void _standbyCheck();
+            void _standbyUpdate(const std::shared_ptr<FilesModelItem>&);
+            void _stampsLoad(const std::shared_ptr<FilesModelItem>&);
+            bool _reloadCheck(const std::shared_ptr<FilesModelItem>&);
+            void _reloadReset(const std::shared_ptr<FilesModelItem>&);
+            bool _isPlayerPooled(const std::shared_ptr<FilesModelItem>&) const;
+            void _playerPoolAdd(
+                const std::shared_ptr<FilesModelItem>&,
+                const std::shared_ptr<tl::timeline::Player>&);
+            std::shared_ptr<tl::timeline::Player> _playerPoolTake(const std::shared_ptr<FilesModelItem>&);
+            void _playerPoolTrim();
+            void _playerPoolRemove();
+            void _playerCacheUpdate();
             void _layersUpdate(const std::vector<int>&);
             void _viewUpdate(const ftk::V2I& pos, double zoom, bool frame);
             void _audioUpdate();
@@ -0,0 +1,872 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djvApp/Exporter.h>
+
+#include <djvApp/ImagePool.h>
+
+#include <tlTimelineGL/Render.h>
+
+#include <tlIO/System.h>
+
+#include <ftk/GL/GL.h>
+#include <ftk/GL/OffscreenBuffer.h>
+#include <ftk/GL/Util.h>
+#include <ftk/Core/Context.h>
+#include <ftk/Core/Format.h>
+#include <ftk/Core/String.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <list>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace djv
+{
+    namespace app
+    {
+        namespace
+        {
+#if defined(FTK_API_GL_4_1)
+            const size_t readbackCount = 3;
+#endif // FTK_API_GL_4_1
+            const size_t writeQueueMax = 4;
+
+            // Copy image data flipping it vertically, since OpenGL reads
+            // the rows from the bottom up.
+            void copyFlipped(const uint8_t* data, const std::shared_ptr<ftk::Image>& image)
+            {
+                const int h = image->getHeight();
+                const size_t rowByteCount = h > 0 ? image->getByteCount() / h : 0;
+                uint8_t* out = image->getData();
+                for (int y = 0; y < h; ++y)
+                {
+                    memcpy(
+                        out + y * rowByteCount,
+                        data + (h - 1 - y) * rowByteCount,
+                        rowByteCount);
+                }
+            }
+        }
+
+        FTK_ENUM_IMPL(
+            ExportShardMode,
+            "Interleaved",
+            "Chunked");
+
+        bool ExportShard::operator == (const ExportShard& other) const
+        {
+            return
+                index == other.index &&
+                count == other.count &&
+                mode == other.mode;
+        }
+
+        bool ExportShard::operator != (const ExportShard& other) const
+        {
+            return !(*this == other);
+        }
+
+        ExportShard parseExportShard(const std::string& value)
+        {
+            ExportShard out;
+            const auto pieces = ftk::split(value, '/');
+            if (pieces.size() != 2)
+            {
+                throw std::invalid_argument(
+                    ftk::Format("Cannot parse the export shard: \"{0}\"").arg(value));
+            }
+            out.index = std::stoi(pieces[0]);
+            out.count = std::stoi(pieces[1]);
+            if (out.count < 1 || out.index < 1 || out.index > out.count)
+            {
+                throw std::invalid_argument(
+                    ftk::Format("Invalid export shard: \"{0}\"").arg(value));
+            }
+            return out;
+        }
+
+        std::vector<int64_t> getFrames(
+            const OTIO_NS::TimeRange& range,
+            const ExportShard& shard)
+        {
+            std::vector<int64_t> out;
+            const int64_t start = range.start_time().value();
+            const int64_t duration = range.duration().value();
+            const int count = std::max(1, shard.count);
+            const int index = std::min(std::max(1, shard.index), count) - 1;
+            switch (shard.mode)
+            {
+            case ExportShardMode::Interleaved:
+                for (int64_t i = index; i < duration; i += count)
+                {
+                    out.push_back(start + i);
+                }
+                break;
+            case ExportShardMode::Chunked:
+            {
+                const int64_t chunkStart = duration * index / count;
+                const int64_t chunkEnd = duration * (index + 1) / count;
+                for (int64_t i = chunkStart; i < chunkEnd; ++i)
+                {
+                    out.push_back(start + i);
+                }
+                break;
+            }
+            default: break;
+            }
+            return out;
+        }
+
+        tl::file::Path getExportPath(
+            const ExportSettings& settings,
+            const OTIO_NS::TimeRange& range)
+        {
+            std::string fileName;
+            switch (settings.fileType)
+            {
+            case ExportFileType::Image:
+            case ExportFileType::Sequence:
+            {
+                std::stringstream ss;
+                ss << settings.imageBaseName;
+                ss << std::setfill('0') << std::setw(settings.imageZeroPad) << range.start_time().value();
+                ss << settings.imageExtension;
+                fileName = ss.str();
+                break;
+            }
+            case ExportFileType::Movie:
+            {
+                std::stringstream ss;
+                ss << settings.movieBaseName << settings.movieExtension;
+                fileName = ss.str();
+                break;
+            }
+            default: break;
+            }
+            return tl::file::Path((std::filesystem::u8path(settings.directory) /
+                std::filesystem::u8path(fileName)).u8string());
+        }
+
+        OTIO_NS::TimeRange getExportRange(
+            const ExportSettings& settings,
+            const ExportOptions& options)
+        {
+            OTIO_NS::TimeRange out = options.range;
+            if (ExportFileType::Image == settings.fileType)
+            {
+                const double rate = options.range.duration().rate();
+                const OTIO_NS::RationalTime time = !options.imageTime.strictly_equal(tl::time::invalidTime) ?
+                    options.imageTime.rescaled_to(rate) :
+                    options.range.start_time();
+                out = OTIO_NS::TimeRange(
+                    OTIO_NS::RationalTime(std::floor(time.value()), rate),
+                    OTIO_NS::RationalTime(1.0, rate));
+            }
+            return out;
+        }
+
+        double ExportStageTiming::getMS() const
+        {
+            return count > 0 ? (seconds * 1000.0 / count) : 0.0;
+        }
+
+        double ExportStageTiming::getFPS() const
+        {
+            return seconds > 0.0 ? (count / seconds) : 0.0;
+        }
+
+        bool ExportStageTiming::operator == (const ExportStageTiming& other) const
+        {
+            return
+                seconds == other.seconds &&
+                count == other.count;
+        }
+
+        bool ExportStageTiming::operator != (const ExportStageTiming& other) const
+        {
+            return !(*this == other);
+        }
+
+        bool ExportTimings::operator == (const ExportTimings& other) const
+        {
+            return
+                decode == other.decode &&
+                render == other.render &&
+                readback == other.readback &&
+                flip == other.flip &&
+                write == other.write;
+        }
+
+        bool ExportTimings::operator != (const ExportTimings& other) const
+        {
+            return !(*this == other);
+        }
+
+        std::string getExportTimingsSummary(const ExportTimings& value)
+        {
+            const std::vector<std::pair<std::string, ExportStageTiming> > stages =
+            {
+                { "Decode", value.decode },
+                { "Render", value.render },
+                { "Readback", value.readback },
+                { "Flip", value.flip },
+                { "Write", value.write }
+            };
+            std::vector<std::string> lines;
+            for (const auto& stage : stages)
+            {
+                lines.push_back(ftk::Format("{0}: {1} ms/frame, {2} fps").
+                    arg(stage.first).
+                    arg(stage.second.getMS(), 2).
+                    arg(stage.second.getFPS(), 1));
+            }
+            return ftk::join(lines, "\n");
+        }
+
+        struct Exporter::Private
+        {
+            std::shared_ptr<tl::timeline::Timeline> timeline;
+            ExportOptions options;
+            tl::io::Options ioOptions;
+            std::vector<tl::file::Path> paths;
+            std::shared_ptr<tl::timeline::IRender> render;
+
+            std::list<tl::timeline::VideoRequest> requests;
+            std::vector<int64_t> frames;
+            size_t rangeFrameCount = 0;
+            int64_t imageFrame = 0;
+            size_t requestIndex = 0;
+            size_t renderIndex = 0;
+
+            ExportTimings timings;
+            bool decodeWaiting = false;
+            std::chrono::steady_clock::time_point decodeTime;
+
+            struct WriteData
+            {
+                std::mutex mutex;
+                std::condition_variable cv;
+                std::list<std::pair<int64_t, std::shared_ptr<ftk::Image> > > queue;
+                size_t queueMax = writeQueueMax;
+                size_t inProgress = 0;
+                std::string error;
+                bool running = true;
+                ExportStageTiming timing;
+            };
+
+#if defined(FTK_API_GL_4_1)
+            struct Readback
+            {
+                GLuint pbo = 0;
+                GLsync fence = nullptr;
+                int64_t frame = 0;
+                double seconds = 0.0;
+            };
+#endif // FTK_API_GL_4_1
+
+            struct Output
+            {
+                ExportSettings settings;
+                ftk::ImageInfo info;
+                GLenum glFormat = 0;
+                GLenum glType = 0;
+                int64_t frameTotal = 0;
+                std::vector<std::shared_ptr<tl::io::IWrite> > writers;
+                std::shared_ptr<ftk::gl::OffscreenBuffer> buffer;
+                std::shared_ptr<ImagePool> imagePool;
+
+                WriteData writeData;
+                std::atomic<int64_t> writeCount;
+                std::vector<std::thread> writeThreads;
+
+#if defined(FTK_API_GL_4_1)
+                std::vector<Readback> readbacks;
+                std::list<size_t> readbacksPending;
+                size_t readbackIndex = 0;
+#else // FTK_API_GL_4_1
+                std::vector<uint8_t> readbackData;
+#endif // FTK_API_GL_4_1
+            };
+            std::vector<std::unique_ptr<Output> > outputs;
+        };
+
+        void Exporter::_init(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::shared_ptr<tl::timeline::Timeline>& timeline,
+            const ExportOptions& options)
+        {
+            FTK_P();
+
+            p.timeline = timeline;
+            p.options = options;
+            if (options.outputs.empty())
+            {
+                throw std::runtime_error("No outputs to export");
+            }
+            if (options.shard.count > 1)
+            {
+                for (const auto& settings : options.outputs)
+                {
+                    if (ExportFileType::Sequence != settings.fileType)
+                    {
+                        throw std::runtime_error("Only image sequences can be split into shards");
+                    }
+                }
+            }
+            p.frames = getFrames(options.range, options.shard);
+            p.rangeFrameCount = p.frames.size();
+
+            // Image outputs are rendered at the image time. If the image
+            // time is outside of the range it is requested after the other
+            // frames.
+            bool images = false;
+            for (const auto& settings : options.outputs)
+            {
+                if (ExportFileType::Image == settings.fileType)
+                {
+                    images = true;
+                    p.imageFrame = getExportRange(settings, options).start_time().value();
+                    break;
+                }
+            }
+            if (images &&
+                std::find(p.frames.begin(), p.frames.end(), p.imageFrame) == p.frames.end())
+            {
+                p.frames.push_back(p.imageFrame);
+            }
+
+            const tl::io::Info& ioInfo = timeline->getIOInfo();
+            if (ioInfo.video.empty())
+            {
+                throw std::runtime_error("No video to render");
+            }
+            p.ioOptions = timeline->getOptions().ioOptions;
+            p.ioOptions["Layer"] = ftk::Format("{0}").arg(options.videoLayer);
+
+            // Create the renderer. The renderer is shared by the outputs.
+            p.render = tl::timeline_gl::Render::create(context->getLogSystem());
+
+            auto ioSystem = context->getSystem<tl::io::WriteSystem>();
+            for (const auto& settings : options.outputs)
+            {
+                auto output = std::unique_ptr<Private::Output>(new Private::Output);
+                output->settings = settings;
+                output->writeCount = 0;
+                const bool image = ExportFileType::Image == settings.fileType;
+                output->frameTotal = image ? 1 : static_cast<int64_t>(p.rangeFrameCount);
+
+                // Get the render size.
+                switch (settings.renderSize)
+                {
+                case ExportRenderSize::Default:
+                    output->info.size = ioInfo.video.front().size;
+                    break;
+                case ExportRenderSize::Custom:
+                    output->info.size = settings.customSize;
+                    break;
+                default:
+                    output->info.size = getSize(settings.renderSize);
+                    break;
+                }
+
+                // Get the writer.
+                const tl::file::Path path = getExportPath(settings, getExportRange(settings, options));
+                auto plugin = ioSystem->getPlugin(path);
+                if (!plugin)
+                {
+                    throw std::runtime_error(
+                        ftk::Format("Cannot open: \"{0}\"").arg(path.get()));
+                }
+                output->info.type = ioInfo.video.front().type;
+                output->info = plugin->getInfo(output->info);
+                if (ftk::ImageType::None == output->info.type)
+                {
+                    output->info.type = ftk::ImageType::RGBA_U8;
+                }
+                output->glFormat = ftk::gl::getReadPixelsFormat(output->info.type);
+                output->glType = ftk::gl::getReadPixelsType(output->info.type);
+                if (GL_NONE == output->glFormat || GL_NONE == output->glType)
+                {
+                    throw std::runtime_error(
+                        ftk::Format("Cannot open: \"{0}\"").arg(path.get()));
+                }
+                tl::io::Info outputInfo;
+                outputInfo.video.push_back(output->info);
+                outputInfo.videoTime = OTIO_NS::TimeRange(
+                    OTIO_NS::RationalTime(0.0, options.speed),
+                    image ?
+                    OTIO_NS::RationalTime(1.0, options.speed) :
+                    options.range.duration().rescaled_to(options.speed));
+                tl::io::Options ioOptions;
+                ioOptions["FFmpeg/Codec"] = settings.movieCodec;
+                // Sequences are written with a writer per thread since every
+                // frame is a separate file. Other file types are written in
+                // order by a single writer.
+                const size_t writerCount = ExportFileType::Sequence == settings.fileType ?
+                    std::max(static_cast<size_t>(1), settings.writeThreads) :
+                    1;
+                for (size_t i = 0; i < writerCount; ++i)
+                {
+                    output->writers.push_back(plugin->write(path, outputInfo, ioOptions));
+                }
+                output->writeData.queueMax = std::max(writeQueueMax, writerCount * 2);
+
+                // Create the image pool. The pool holds enough images for the
+                // readbacks and the write queue.
+                output->imagePool = ImagePool::create(output->writeData.queueMax + 4);
+
+                // Create the offscreen buffer.
+                ftk::gl::OffscreenBufferOptions offscreenBufferOptions;
+                offscreenBufferOptions.color = options.colorBuffer;
+                output->buffer = ftk::gl::OffscreenBuffer::create(output->info.size, offscreenBufferOptions);
+
+                // Create the readback buffers.
+                const size_t byteCount = output->info.getByteCount();
+#if defined(FTK_API_GL_4_1)
+                output->readbacks.resize(readbackCount);
+                for (auto& readback : output->readbacks)
+                {
+                    glGenBuffers(1, &readback.pbo);
+                    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+                    glBufferData(GL_PIXEL_PACK_BUFFER, byteCount, nullptr, GL_STREAM_READ);
+                }
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+#else // FTK_API_GL_4_1
+                output->readbackData.resize(byteCount);
+#endif // FTK_API_GL_4_1
+
+                p.paths.push_back(path);
+                p.outputs.push_back(std::move(output));
+            }
+
+            // Start the writer threads.
+            for (size_t i = 0; i < p.outputs.size(); ++i)
+            {
+                for (const auto& writer : p.outputs[i]->writers)
+                {
+                    p.outputs[i]->writeThreads.push_back(std::thread(
+                        [this, i, writer]
+                        {
+                            _writeRun(i, writer);
+                        }));
+                }
+            }
+        }
+
+        Exporter::Exporter() :
+            _p(new Private)
+        {}
+
+        Exporter::~Exporter()
+        {
+            FTK_P();
+            for (auto& output : p.outputs)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(output->writeData.mutex);
+                    output->writeData.running = false;
+                }
+                output->writeData.cv.notify_all();
+            }
+            for (auto& output : p.outputs)
+            {
+                for (auto& thread : output->writeThreads)
+                {
+                    if (thread.joinable())
+                    {
+                        thread.join();
+                    }
+                }
+            }
+            std::vector<uint64_t> ids;
+            for (const auto& request : p.requests)
+            {
+                ids.push_back(request.id);
+            }
+            if (!ids.empty())
+            {
+                p.timeline->cancelRequests(ids);
+            }
+#if defined(FTK_API_GL_4_1)
+            for (auto& output : p.outputs)
+            {
+                for (auto& readback : output->readbacks)
+                {
+                    if (readback.fence)
+                    {
+                        glDeleteSync(readback.fence);
+                    }
+                    glDeleteBuffers(1, &readback.pbo);
+                }
+            }
+#endif // FTK_API_GL_4_1
+        }
+
+        std::shared_ptr<Exporter> Exporter::create(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::shared_ptr<tl::timeline::Timeline>& timeline,
+            const ExportOptions& options)
+        {
+            auto out = std::shared_ptr<Exporter>(new Exporter);
+            out->_init(context, timeline, options);
+            return out;
+        }
+
+        const std::vector<tl::file::Path>& Exporter::getPaths() const
+        {
+            return _p->paths;
+        }
+
+        const OTIO_NS::TimeRange& Exporter::getRange() const
+        {
+            return _p->options.range;
+        }
+
+        int64_t Exporter::getFrameTotal() const
+        {
+            return _p->rangeFrameCount;
+        }
+
+        int64_t Exporter::getFrameCount() const
+        {
+            FTK_P();
+            // Image outputs only write a single frame, so the counts are
+            // scaled to the number of frames before taking the minimum.
+            const int64_t frameTotal = p.rangeFrameCount;
+            int64_t out = frameTotal;
+            for (const auto& output : p.outputs)
+            {
+                if (output->frameTotal > 0)
+                {
+                    out = std::min(out, output->writeCount * frameTotal / output->frameTotal);
+                }
+            }
+            return out;
+        }
+
+        ExportTimings Exporter::getTimings() const
+        {
+            FTK_P();
+            ExportTimings out = p.timings;
+            for (const auto& output : p.outputs)
+            {
+                std::unique_lock<std::mutex> lock(output->writeData.mutex);
+                out.write.seconds += output->writeData.timing.seconds;
+                out.write.count += output->writeData.timing.count;
+            }
+            return out;
+        }
+
+        bool Exporter::isFinished() const
+        {
+            FTK_P();
+            bool out = true;
+            for (const auto& output : p.outputs)
+            {
+                out &= output->writeCount >= output->frameTotal;
+            }
+            return out;
+        }
+
+        void Exporter::tick()
+        {
+            FTK_P();
+            for (const auto& output : p.outputs)
+            {
+                std::unique_lock<std::mutex> lock(output->writeData.mutex);
+                if (!output->writeData.error.empty())
+                {
+                    throw std::runtime_error(output->writeData.error);
+                }
+            }
+            // Add the time spent waiting for the next frame to be decoded.
+            const auto t = std::chrono::steady_clock::now();
+            if (p.decodeWaiting)
+            {
+                p.timings.decode.seconds += std::chrono::duration<double>(t - p.decodeTime).count();
+            }
+
+            _requestVideo();
+            for (size_t i = 0; i < p.outputs.size(); ++i)
+            {
+                while (_readback(i, false))
+                    ;
+            }
+            while (!_isWriteQueueFull() &&
+                !p.requests.empty() &&
+                p.requests.front().future.valid() &&
+                p.requests.front().future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+            {
+                const auto video = p.requests.front().future.get();
+                p.requests.pop_front();
+                ++p.timings.decode.count;
+                _renderVideo(video);
+                _requestVideo();
+                for (size_t i = 0; i < p.outputs.size(); ++i)
+                {
+                    while (_readback(i, false))
+                        ;
+                }
+            }
+            if (p.renderIndex >= p.frames.size())
+            {
+                // Wait for the remaining readbacks.
+                for (size_t i = 0; i < p.outputs.size(); ++i)
+                {
+                    while (_readback(i, true))
+                        ;
+                }
+            }
+
+            p.decodeWaiting =
+                !_isWriteQueueFull() &&
+                !p.requests.empty() &&
+                p.requests.front().future.valid() &&
+                p.requests.front().future.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+            p.decodeTime = std::chrono::steady_clock::now();
+        }
+
+        void Exporter::_requestVideo()
+        {
+            FTK_P();
+            const size_t max = std::max(static_cast<size_t>(1), p.options.videoRequests);
+            while (p.requests.size() < max && p.requestIndex < p.frames.size())
+            {
+                const OTIO_NS::RationalTime t(
+                    p.frames[p.requestIndex],
+                    p.options.range.duration().rate());
+                p.requests.push_back(p.timeline->getVideo(t, p.ioOptions));
+                ++p.requestIndex;
+            }
+        }
+
+        void Exporter::_renderVideo(const tl::timeline::VideoData& video)
+        {
+            FTK_P();
+            const int64_t frame = p.frames[p.renderIndex];
+            for (size_t i = 0; i < p.outputs.size(); ++i)
+            {
+                auto& output = *p.outputs[i];
+                const bool image = ExportFileType::Image == output.settings.fileType;
+                if ((image && frame != p.imageFrame) ||
+                    (!image && p.renderIndex >= p.rangeFrameCount))
+                {
+                    continue;
+                }
+
+#if defined(FTK_API_GL_4_1)
+                // Wait for the readback buffer to be available.
+                while (output.readbacksPending.size() >= output.readbacks.size() && _readback(i, true))
+                    ;
+#endif // FTK_API_GL_4_1
+
+                // Render the video.
+                auto t0 = std::chrono::steady_clock::now();
+                ftk::gl::OffscreenBufferBinding binding(output.buffer);
+                p.render->begin(output.info.size);
+                p.render->setOCIOOptions(p.options.ocioOptions);
+                p.render->setLUTOptions(p.options.lutOptions);
+                p.render->drawVideo(
+                    { video },
+                    { ftk::Box2I(0, 0, output.info.size.w, output.info.size.h) },
+                    { p.options.imageOptions },
+                    { p.options.displayOptions },
+                    tl::timeline::CompareOptions(),
+                    p.options.colorBuffer);
+                p.render->end();
+                auto t1 = std::chrono::steady_clock::now();
+                p.timings.render.seconds += std::chrono::duration<double>(t1 - t0).count();
+                ++p.timings.render.count;
+
+                // Start the readback. The image is flipped when it is copied
+                // from the readback buffer.
+                glPixelStorei(GL_PACK_ALIGNMENT, output.info.layout.alignment);
+#if defined(FTK_API_GL_4_1)
+                glPixelStorei(GL_PACK_SWAP_BYTES, output.info.layout.endian != ftk::getEndian());
+                auto& readback = output.readbacks[output.readbackIndex];
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+                glReadPixels(
+                    0,
+                    0,
+                    output.info.size.w,
+                    output.info.size.h,
+                    output.glFormat,
+                    output.glType,
+                    nullptr);
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+                readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                readback.frame = frame;
+                readback.seconds = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - t1).count();
+                output.readbacksPending.push_back(output.readbackIndex);
+                output.readbackIndex = (output.readbackIndex + 1) % output.readbacks.size();
+#else // FTK_API_GL_4_1
+                glReadPixels(
+                    0,
+                    0,
+                    output.info.size.w,
+                    output.info.size.h,
+                    output.glFormat,
+                    output.glType,
+                    output.readbackData.data());
+                t0 = std::chrono::steady_clock::now();
+                p.timings.readback.seconds += std::chrono::duration<double>(t0 - t1).count();
+                ++p.timings.readback.count;
+                auto image = output.imagePool->get(output.info);
+                copyFlipped(output.readbackData.data(), image);
+                p.timings.flip.seconds += std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - t0).count();
+                ++p.timings.flip.count;
+                _writeVideo(i, frame, image);
+#endif // FTK_API_GL_4_1
+            }
+            ++p.renderIndex;
+        }
+
+        bool Exporter::_readback(size_t index, bool wait)
+        {
+            bool out = false;
+#if defined(FTK_API_GL_4_1)
+            FTK_P();
+            auto& output = *p.outputs[index];
+            if (!output.readbacksPending.empty() && !_isWriteQueueFull(index))
+            {
+                auto& readback = output.readbacks[output.readbacksPending.front()];
+                const auto t0 = std::chrono::steady_clock::now();
+                const GLenum result = glClientWaitSync(
+                    readback.fence,
+                    wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0,
+                    wait ? std::numeric_limits<GLuint64>::max() : 0);
+                if (GL_ALREADY_SIGNALED == result || GL_CONDITION_SATISFIED == result)
+                {
+                    auto image = output.imagePool->get(output.info);
+                    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+                    if (void* data = glMapBufferRange(
+                        GL_PIXEL_PACK_BUFFER,
+                        0,
+                        image->getByteCount(),
+                        GL_MAP_READ_BIT))
+                    {
+                        const auto t1 = std::chrono::steady_clock::now();
+                        p.timings.readback.seconds += readback.seconds +
+                            std::chrono::duration<double>(t1 - t0).count();
+                        ++p.timings.readback.count;
+                        copyFlipped(reinterpret_cast<const uint8_t*>(data), image);
+                        p.timings.flip.seconds += std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - t1).count();
+                        ++p.timings.flip.count;
+                        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+                    }
+                    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+                    glDeleteSync(readback.fence);
+                    readback.fence = nullptr;
+                    output.readbacksPending.pop_front();
+                    _writeVideo(index, readback.frame, image);
+                    out = true;
+                }
+                else if (GL_WAIT_FAILED == result)
+                {
+                    throw std::runtime_error("Cannot read the rendered image");
+                }
+            }
+#endif // FTK_API_GL_4_1
+            return out;
+        }
+
+        bool Exporter::_isWriteQueueFull()
+        {
+            FTK_P();
+            bool out = false;
+            for (size_t i = 0; i < p.outputs.size() && !out; ++i)
+            {
+                out = _isWriteQueueFull(i);
+            }
+            return out;
+        }
+
+        bool Exporter::_isWriteQueueFull(size_t index)
+        {
+            FTK_P();
+            auto& writeData = p.outputs[index]->writeData;
+            std::unique_lock<std::mutex> lock(writeData.mutex);
+            return writeData.queue.size() + writeData.inProgress >= writeData.queueMax;
+        }
+
+        void Exporter::_writeVideo(
+            size_t index,
+            int64_t frame,
+            const std::shared_ptr<ftk::Image>& image)
+        {
+            FTK_P();
+            auto& writeData = p.outputs[index]->writeData;
+            {
+                std::unique_lock<std::mutex> lock(writeData.mutex);
+                writeData.queue.push_back(std::make_pair(frame, image));
+            }
+            writeData.cv.notify_all();
+        }
+
+        void Exporter::_writeRun(
+            size_t index,
+            const std::shared_ptr<tl::io::IWrite>& writer)
+        {
+            FTK_P();
+            auto& output = *p.outputs[index];
+            auto& writeData = output.writeData;
+            const bool image = ExportFileType::Image == output.settings.fileType;
+            const int64_t start = p.options.range.start_time().value();
+            while (true)
+            {
+                std::pair<int64_t, std::shared_ptr<ftk::Image> > item;
+                {
+                    std::unique_lock<std::mutex> lock(writeData.mutex);
+                    writeData.cv.wait(
+                        lock,
+                        [&writeData]
+                        {
+                            return
+                                !writeData.queue.empty() ||
+                                !writeData.running;
+                        });
+                    if (!writeData.running)
+                    {
+                        break;
+                    }
+                    item = writeData.queue.front();
+                    writeData.queue.pop_front();
+                    ++writeData.inProgress;
+                }
+                const auto t0 = std::chrono::steady_clock::now();
+                try
+                {
+                    const OTIO_NS::RationalTime t(image ? 0 : (item.first - start), p.options.speed);
+                    writer->writeVideo(t, item.second);
+                }
+                catch (const std::exception& e)
+                {
+                    std::unique_lock<std::mutex> lock(writeData.mutex);
+                    writeData.error = e.what();
+                    writeData.running = false;
+                    break;
+                }
+                const auto t1 = std::chrono::steady_clock::now();
+                {
+                    std::unique_lock<std::mutex> lock(writeData.mutex);
+                    --writeData.inProgress;
+                    writeData.timing.seconds += std::chrono::duration<double>(t1 - t0).count();
+                    ++writeData.timing.count;
+                }
+                ++output.writeCount;
+                writeData.cv.notify_all();
+            }
+        }
+    }
+}
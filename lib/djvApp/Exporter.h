@@ -0,0 +1,187 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <djvApp/Models/SettingsModel.h>
+
+#include <tlTimeline/IRender.h>
+#include <tlTimeline/Timeline.h>
+
+namespace ftk
+{
+    class Context;
+}
+
+namespace djv
+{
+    namespace app
+    {
+        //! Export shard modes.
+        enum class ExportShardMode
+        {
+            Interleaved,
+            Chunked,
+
+            Count,
+            First = Interleaved
+        };
+        FTK_ENUM(ExportShardMode);
+
+        //! Export shard. The shard index is from one to the shard count.
+        struct ExportShard
+        {
+            int index = 1;
+            int count = 1;
+            ExportShardMode mode = ExportShardMode::Interleaved;
+
+            bool operator == (const ExportShard&) const;
+            bool operator != (const ExportShard&) const;
+        };
+
+        //! Parse an export shard (e.g., "3/8").
+        ExportShard parseExportShard(const std::string&);
+
+        //! Get the frames of a time range that belong to a shard.
+        std::vector<int64_t> getFrames(const OTIO_NS::TimeRange&, const ExportShard&);
+
+        //! Get the path of an export output. The time range start is used
+        //! for the first frame number of image sequences.
+        tl::file::Path getExportPath(const ExportSettings&, const OTIO_NS::TimeRange&);
+
+        //! Export options.
+        //!
+        //! Each output has its own render size, file type, and codec. The
+        //! video request count is for the job, since the frames are decoded
+        //! once for all of the outputs. Image outputs are written with the image time, which may be outside
+        //! of the range. If the image time is invalid the start of the range
+        //! is used.
+        struct ExportOptions
+        {
+            OTIO_NS::TimeRange range = tl::time::invalidTimeRange;
+            OTIO_NS::RationalTime imageTime = tl::time::invalidTime;
+            int videoLayer = 0;
+            double speed = 0.0;
+            size_t videoRequests = 4;
+            std::vector<ExportSettings> outputs;
+            tl::timeline::OCIOOptions ocioOptions;
+            tl::timeline::LUTOptions lutOptions;
+            ftk::ImageOptions imageOptions;
+            tl::timeline::DisplayOptions displayOptions;
+            ftk::ImageType colorBuffer = ftk::ImageType::RGBA_U8;
+            ExportShard shard;
+        };
+
+        //! Get the time range of an export output. Image outputs have a
+        //! single frame at the image time.
+        OTIO_NS::TimeRange getExportRange(const ExportSettings&, const ExportOptions&);
+
+        //! Export stage timing.
+        struct ExportStageTiming
+        {
+            double seconds = 0.0;
+            int64_t count = 0;
+
+            //! Get the average time per frame in milliseconds.
+            double getMS() const;
+
+            //! Get the number of frames per second.
+            double getFPS() const;
+
+            bool operator == (const ExportStageTiming&) const;
+            bool operator != (const ExportStageTiming&) const;
+        };
+
+        //! Export stage timings.
+        //!
+        //! The decode timing is the time spent waiting for the next frame to
+        //! be decoded. The render timing is the time taken to issue the draw
+        //! commands, time spent waiting for the GPU is included in the
+        //! readback timing. The flip timing is the time taken to copy the
+        //! image out of the readback buffer. The write timing is summed
+        //! across the writer threads.
+        struct ExportTimings
+        {
+            ExportStageTiming decode;
+            ExportStageTiming render;
+            ExportStageTiming readback;
+            ExportStageTiming flip;
+            ExportStageTiming write;
+
+            bool operator == (const ExportTimings&) const;
+            bool operator != (const ExportTimings&) const;
+        };
+
+        //! Get a summary of the export timings with a line for each stage.
+        std::string getExportTimingsSummary(const ExportTimings&);
+
+        //! Exporter.
+        //!
+        //! The exporter renders a timeline and writes the frames to disk.
+        //! Every frame is decoded once and then rendered and written for
+        //! each output. Video is requested ahead of the render stage so that decoding
+        //! overlaps with rendering and writing, and rendered frames are read
+        //! back asynchronously through a ring of pixel buffers. Frames are
+        //! written on separate threads through a bounded queue; when the
+        //! queue is full rendering waits for the writers. Image sequences
+        //! are written in parallel with a writer per thread. The exporter
+        //! must be created, ticked, and destroyed with an OpenGL context
+        //! current.
+        class Exporter : public std::enable_shared_from_this<Exporter>
+        {
+            FTK_NON_COPYABLE(Exporter);
+
+        protected:
+            void _init(
+                const std::shared_ptr<ftk::Context>&,
+                const std::shared_ptr<tl::timeline::Timeline>&,
+                const ExportOptions&);
+
+            Exporter();
+
+        public:
+            ~Exporter();
+
+            //! Create a new exporter. An exception is thrown if the output
+            //! file cannot be written.
+            static std::shared_ptr<Exporter> create(
+                const std::shared_ptr<ftk::Context>&,
+                const std::shared_ptr<tl::timeline::Timeline>&,
+                const ExportOptions&);
+
+            //! Get the output paths.
+            const std::vector<tl::file::Path>& getPaths() const;
+
+            //! Get the time range.
+            const OTIO_NS::TimeRange& getRange() const;
+
+            //! Get the number of frames to write.
+            int64_t getFrameTotal() const;
+
+            //! Get the number of frames written to every output.
+            int64_t getFrameCount() const;
+
+            //! Get the stage timings.
+            ExportTimings getTimings() const;
+
+            //! Get whether the export is finished.
+            bool isFinished() const;
+
+            //! Render the frames that are ready and queue them for writing.
+            //! This function does not wait for the video to be decoded or
+            //! written. An exception is thrown if writing fails.
+            void tick();
+
+        private:
+            void _requestVideo();
+            void _renderVideo(const tl::timeline::VideoData&);
+            bool _readback(size_t output, bool wait);
+            bool _isWriteQueueFull();
+            bool _isWriteQueueFull(size_t output);
+            void _writeVideo(size_t output, int64_t frame, const std::shared_ptr<ftk::Image>&);
+            void _writeRun(size_t output, const std::shared_ptr<tl::io::IWrite>&);
+
+            FTK_PRIVATE();
+        };
+    }
+}
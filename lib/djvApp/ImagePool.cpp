@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djvApp/ImagePool.h>
+
+#include <list>
+#include <mutex>
+
+namespace djv
+{
+    namespace app
+    {
+        struct ImagePool::Private
+        {
+            std::mutex mutex;
+            size_t max = 8;
+            std::list<std::shared_ptr<ftk::Image> > images;
+        };
+
+        ImagePool::ImagePool() :
+            _p(new Private)
+        {}
+
+        ImagePool::~ImagePool()
+        {}
+
+        std::shared_ptr<ImagePool> ImagePool::create(size_t max)
+        {
+            auto out = std::shared_ptr<ImagePool>(new ImagePool);
+            out->_p->max = max;
+            return out;
+        }
+
+        std::shared_ptr<ftk::Image> ImagePool::get(const ftk::ImageInfo& info)
+        {
+            FTK_P();
+            std::shared_ptr<ftk::Image> image;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                for (auto i = p.images.begin(); i != p.images.end(); ++i)
+                {
+                    if ((*i)->getInfo() == info)
+                    {
+                        image = *i;
+                        p.images.erase(i);
+                        break;
+                    }
+                }
+            }
+            if (!image)
+            {
+                image = ftk::Image::create(info);
+            }
+
+            // The returned pointer shares the image and gives it back to
+            // the pool when the last reference is released.
+            std::weak_ptr<ImagePool> poolWeak(shared_from_this());
+            return std::shared_ptr<ftk::Image>(
+                image.get(),
+                [poolWeak, image](ftk::Image*)
+                {
+                    if (auto pool = poolWeak.lock())
+                    {
+                        pool->_release(image);
+                    }
+                });
+        }
+
+        void ImagePool::setMax(size_t value)
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.max = value;
+            while (p.images.size() > p.max)
+            {
+                p.images.pop_back();
+            }
+        }
+
+        void ImagePool::clear()
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.images.clear();
+        }
+
+        void ImagePool::_release(const std::shared_ptr<ftk::Image>& image)
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            if (p.images.size() < p.max)
+            {
+                p.images.push_front(image);
+            }
+        }
+    }
+}
@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <ftk/Core/Image.h>
+
+namespace djv
+{
+    namespace app
+    {
+        //! Image pool.
+        //!
+        //! The pool recycles images with the same information, so that
+        //! steady state rendering does not allocate new images. Images are
+        //! returned to the pool when the last reference is released. The
+        //! functions are thread safe.
+        class ImagePool : public std::enable_shared_from_this<ImagePool>
+        {
+            FTK_NON_COPYABLE(ImagePool);
+
+        protected:
+            ImagePool();
+
+        public:
+            ~ImagePool();
+
+            //! Create a new pool.
+            static std::shared_ptr<ImagePool> create(size_t max = 8);
+
+            //! Get an image. The image data is not initialized.
+            std::shared_ptr<ftk::Image> get(const ftk::ImageInfo&);
+
+            //! Set the maximum number of unused images kept in the pool.
+            void setMax(size_t);
+
+            //! Clear the unused images.
+            void clear();
+
+        private:
+            void _release(const std::shared_ptr<ftk::Image>&);
+
+            FTK_PRIVATE();
+        };
+    }
+}
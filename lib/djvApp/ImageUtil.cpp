@@ -0,0 +1,398 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djvApp/ImageUtil.h>
+
+#include <ftk/Core/Format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <limits>
+#include <thread>
+
+namespace djv
+{
+    namespace app
+    {
+        namespace
+        {
+            float halfToFloat(uint16_t value)
+            {
+                const uint32_t sign = (value & 0x8000) << 16;
+                const uint32_t exponent = (value >> 10) & 0x1f;
+                uint32_t mantissa = value & 0x3ff;
+                uint32_t bits = 0;
+                if (0 == exponent)
+                {
+                    if (mantissa != 0)
+                    {
+                        // Denormalized.
+                        int e = -1;
+                        do
+                        {
+                            ++e;
+                            mantissa <<= 1;
+                        } while (0 == (mantissa & 0x400));
+                        bits = sign | ((127 - 15 - e) << 23) | ((mantissa & 0x3ff) << 13);
+                    }
+                    else
+                    {
+                        bits = sign;
+                    }
+                }
+                else if (0x1f == exponent)
+                {
+                    bits = sign | 0x7f800000 | (mantissa << 13);
+                }
+                else
+                {
+                    bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+                }
+                float out = 0.F;
+                memcpy(&out, &bits, sizeof(float));
+                return out;
+            }
+
+            struct U8
+            {
+                typedef uint8_t Type;
+                static float get(Type value) { return value / 255.F; }
+            };
+
+            struct U16
+            {
+                typedef uint16_t Type;
+                static float get(Type value) { return value / 65535.F; }
+            };
+
+            struct F16
+            {
+                typedef uint16_t Type;
+                static float get(Type value) { return halfToFloat(value); }
+            };
+
+            struct F32
+            {
+                typedef float Type;
+                static float get(Type value) { return value; }
+            };
+
+            template<typename T, size_t C>
+            void readRow(const uint8_t* data, int x, int count, int step, float* out)
+            {
+                const typename T::Type* p = reinterpret_cast<const typename T::Type*>(data) + x * C;
+                for (int i = 0; i < count; ++i, p += step * C, out += 4)
+                {
+                    out[0] = T::get(p[0]);
+                    switch (C)
+                    {
+                    case 1:
+                        out[1] = out[2] = out[0];
+                        out[3] = 1.F;
+                        break;
+                    case 2:
+                        out[1] = out[2] = out[0];
+                        out[3] = T::get(p[1]);
+                        break;
+                    case 3:
+                        out[1] = T::get(p[1]);
+                        out[2] = T::get(p[2]);
+                        out[3] = 1.F;
+                        break;
+                    case 4:
+                        out[1] = T::get(p[1]);
+                        out[2] = T::get(p[2]);
+                        out[3] = T::get(p[3]);
+                        break;
+                    }
+                }
+            }
+
+            typedef void (*ReadRow)(const uint8_t*, int, int, int, float*);
+
+            // Planar YUV images have a full size Y plane, followed by the U
+            // and V planes which are subsampled by the given factors.
+            template<typename T, int SX, int SY>
+            void readYUV(
+                const std::shared_ptr<ftk::Image>& image,
+                int x,
+                int y,
+                int count,
+                int step,
+                float* out)
+            {
+                const ftk::ImageInfo& info = image->getInfo();
+                const int w = info.size.w;
+                const int h = info.size.h;
+                const int cw = (w + SX - 1) / SX;
+                const int ch = (h + SY - 1) / SY;
+                const typename T::Type* yPlane = reinterpret_cast<const typename T::Type*>(image->getData());
+                const typename T::Type* uPlane = yPlane + static_cast<size_t>(w) * h;
+                const typename T::Type* vPlane = uPlane + static_cast<size_t>(cw) * ch;
+                const typename T::Type* yRow = yPlane + static_cast<size_t>(y) * w;
+                const typename T::Type* uRow = uPlane + static_cast<size_t>(y / SY) * cw;
+                const typename T::Type* vRow = vPlane + static_cast<size_t>(y / SY) * cw;
+
+                // Rec. 709 coefficients are used unless the image is BT.2020.
+                float kr = 1.5748F;
+                float kgu = .187324F;
+                float kgv = .468124F;
+                float kb = 1.8556F;
+                if (ftk::YUVCoefficients::BT2020 == info.yuvCoefficients)
+                {
+                    kr = 1.4746F;
+                    kgu = .16455F;
+                    kgv = .57135F;
+                    kb = 1.8814F;
+                }
+                const bool legal = ftk::VideoLevels::LegalRange == info.videoLevels;
+                for (int i = 0, px = x; i < count; ++i, px += step, out += 4)
+                {
+                    float yv = T::get(yRow[px]);
+                    float uv = T::get(uRow[px / SX]) - .5F;
+                    float vv = T::get(vRow[px / SX]) - .5F;
+                    if (legal)
+                    {
+                        yv = (yv - 16.F / 255.F) * 255.F / 219.F;
+                        uv = uv * 255.F / 224.F;
+                        vv = vv * 255.F / 224.F;
+                    }
+                    out[0] = yv + kr * vv;
+                    out[1] = yv - kgu * uv - kgv * vv;
+                    out[2] = yv + kb * uv;
+                    out[3] = 1.F;
+                }
+            }
+
+            typedef void (*ReadYUV)(const std::shared_ptr<ftk::Image>&, int, int, int, int, float*);
+
+            ReadYUV getReadYUV(ftk::ImageType value)
+            {
+                ReadYUV out = nullptr;
+                switch (value)
+                {
+                case ftk::ImageType::YUV_420P_U8: out = readYUV<U8, 2, 2>; break;
+                case ftk::ImageType::YUV_422P_U8: out = readYUV<U8, 2, 1>; break;
+                case ftk::ImageType::YUV_444P_U8: out = readYUV<U8, 1, 1>; break;
+                case ftk::ImageType::YUV_420P_U16: out = readYUV<U16, 2, 2>; break;
+                case ftk::ImageType::YUV_422P_U16: out = readYUV<U16, 2, 1>; break;
+                case ftk::ImageType::YUV_444P_U16: out = readYUV<U16, 1, 1>; break;
+                default: break;
+                }
+                return out;
+            }
+
+            ReadRow getReadRow(ftk::ImageType value)
+            {
+                ReadRow out = nullptr;
+                switch (value)
+                {
+                case ftk::ImageType::L_U8: out = readRow<U8, 1>; break;
+                case ftk::ImageType::L_U16: out = readRow<U16, 1>; break;
+                case ftk::ImageType::L_F16: out = readRow<F16, 1>; break;
+                case ftk::ImageType::L_F32: out = readRow<F32, 1>; break;
+                case ftk::ImageType::LA_U8: out = readRow<U8, 2>; break;
+                case ftk::ImageType::LA_U16: out = readRow<U16, 2>; break;
+                case ftk::ImageType::LA_F16: out = readRow<F16, 2>; break;
+                case ftk::ImageType::LA_F32: out = readRow<F32, 2>; break;
+                case ftk::ImageType::RGB_U8: out = readRow<U8, 3>; break;
+                case ftk::ImageType::RGB_U16: out = readRow<U16, 3>; break;
+                case ftk::ImageType::RGB_F16: out = readRow<F16, 3>; break;
+                case ftk::ImageType::RGB_F32: out = readRow<F32, 3>; break;
+                case ftk::ImageType::RGBA_U8: out = readRow<U8, 4>; break;
+                case ftk::ImageType::RGBA_U16: out = readRow<U16, 4>; break;
+                case ftk::ImageType::RGBA_F16: out = readRow<F16, 4>; break;
+                case ftk::ImageType::RGBA_F32: out = readRow<F32, 4>; break;
+                default: break;
+                }
+                return out;
+            }
+        }
+
+        bool isReadable(ftk::ImageType value)
+        {
+            return getReadRow(value) != nullptr || getReadYUV(value) != nullptr;
+        }
+
+        std::string getUnreadableText(ftk::ImageType value)
+        {
+            return ftk::Format("Unsupported pixel type: {0}").arg(ftk::to_string(value));
+        }
+
+        void readPixels(
+            const std::shared_ptr<ftk::Image>& image,
+            int x,
+            int y,
+            int count,
+            int step,
+            float* out)
+        {
+            const int h = image->getHeight();
+            if (auto readRow = getReadRow(image->getType()))
+            {
+                if (h > 0)
+                {
+                    const size_t rowByteCount = image->getByteCount() / h;
+                    readRow(image->getData() + y * rowByteCount, x, count, step, out);
+                }
+            }
+            else if (auto readYUV = getReadYUV(image->getType()))
+            {
+                readYUV(image, x, y, count, step, out);
+            }
+        }
+
+        bool ImageStats::operator == (const ImageStats& other) const
+        {
+            return
+                min == other.min &&
+                max == other.max &&
+                mean == other.mean &&
+                pixelCount == other.pixelCount &&
+                nanCount == other.nanCount &&
+                infCount == other.infCount &&
+                negativeCount == other.negativeCount;
+        }
+
+        bool ImageStats::operator != (const ImageStats& other) const
+        {
+            return !(*this == other);
+        }
+
+        namespace
+        {
+            struct StatsData
+            {
+                float min[4];
+                float max[4];
+                double sum[4] = { 0.0, 0.0, 0.0, 0.0 };
+                size_t count[4] = { 0, 0, 0, 0 };
+                size_t nanCount = 0;
+                size_t infCount = 0;
+                size_t negativeCount = 0;
+
+                StatsData()
+                {
+                    for (size_t c = 0; c < 4; ++c)
+                    {
+                        min[c] = std::numeric_limits<float>::max();
+                        max[c] = std::numeric_limits<float>::lowest();
+                    }
+                }
+            };
+
+            void getStats(const std::shared_ptr<ftk::Image>& image, int y0, int y1, StatsData& data)
+            {
+                const int w = image->getWidth();
+                std::vector<float> row(static_cast<size_t>(w) * 4);
+                for (int y = y0; y < y1; ++y)
+                {
+                    readPixels(image, 0, y, w, 1, row.data());
+                    const float* p = row.data();
+                    for (int x = 0; x < w; ++x, p += 4)
+                    {
+                        bool nan = false;
+                        bool inf = false;
+                        bool negative = false;
+                        for (size_t c = 0; c < 4; ++c)
+                        {
+                            const float v = p[c];
+                            if (std::isnan(v))
+                            {
+                                nan = true;
+                            }
+                            else if (std::isinf(v))
+                            {
+                                inf = true;
+                            }
+                            else
+                            {
+                                negative |= v < 0.F;
+                                data.min[c] = std::min(data.min[c], v);
+                                data.max[c] = std::max(data.max[c], v);
+                                data.sum[c] += v;
+                                ++data.count[c];
+                            }
+                        }
+                        data.nanCount += nan;
+                        data.infCount += inf;
+                        data.negativeCount += negative;
+                    }
+                }
+            }
+        }
+
+        ImageStats getImageStats(const std::shared_ptr<ftk::Image>& image)
+        {
+            ImageStats out;
+            if (!image || !isReadable(image->getType()))
+                return out;
+            const int h = image->getHeight();
+            if (image->getWidth() <= 0 || h <= 0)
+                return out;
+
+            // Divide the rows between threads.
+            const int threadCount = std::max(1, std::min(
+                static_cast<int>(std::thread::hardware_concurrency()),
+                h / 16));
+            const int rowsPerThread = (h + threadCount - 1) / threadCount;
+            std::vector<StatsData> data(threadCount);
+            std::vector<std::future<void> > futures;
+            for (int i = 1; i < threadCount; ++i)
+            {
+                const int y0 = std::min(h, i * rowsPerThread);
+                const int y1 = std::min(h, (i + 1) * rowsPerThread);
+                auto& threadData = data[i];
+                futures.push_back(std::async(
+                    std::launch::async,
+                    [image, y0, y1, &threadData]
+                    {
+                        getStats(image, y0, y1, threadData);
+                    }));
+            }
+            getStats(image, 0, std::min(h, rowsPerThread), data[0]);
+            for (auto& future : futures)
+            {
+                future.get();
+            }
+
+            // Reduce the results.
+            StatsData total;
+            for (const auto& i : data)
+            {
+                for (size_t c = 0; c < 4; ++c)
+                {
+                    total.min[c] = std::min(total.min[c], i.min[c]);
+                    total.max[c] = std::max(total.max[c], i.max[c]);
+                    total.sum[c] += i.sum[c];
+                    total.count[c] += i.count[c];
+                }
+                total.nanCount += i.nanCount;
+                total.infCount += i.infCount;
+                total.negativeCount += i.negativeCount;
+            }
+            float min[4] = { 0.F, 0.F, 0.F, 0.F };
+            float max[4] = { 0.F, 0.F, 0.F, 0.F };
+            float mean[4] = { 0.F, 0.F, 0.F, 0.F };
+            for (size_t c = 0; c < 4; ++c)
+            {
+                if (total.count[c] > 0)
+                {
+                    min[c] = total.min[c];
+                    max[c] = total.max[c];
+                    mean[c] = total.sum[c] / total.count[c];
+                }
+            }
+            out.min = ftk::Color4F(min[0], min[1], min[2], min[3]);
+            out.max = ftk::Color4F(max[0], max[1], max[2], max[3]);
+            out.mean = ftk::Color4F(mean[0], mean[1], mean[2], mean[3]);
+            out.pixelCount = static_cast<size_t>(image->getWidth()) * h;
+            out.nanCount = total.nanCount;
+            out.infCount = total.infCount;
+            out.negativeCount = total.negativeCount;
+            return out;
+        }
+    }
+}
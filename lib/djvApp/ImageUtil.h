@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <ftk/Core/Color.h>
+#include <ftk/Core/Image.h>
+
+namespace djv
+{
+    namespace app
+    {
+        //! Get whether pixels can be read from an image type with
+        //! readPixels(). Luminance, RGB, and planar YUV types are supported.
+        bool isReadable(ftk::ImageType);
+
+        //! Get the message shown for an image type that cannot be read.
+        std::string getUnreadableText(ftk::ImageType);
+
+        //! Read pixels from a row of an image as RGBA floats. The pixels
+        //! x, x + step, x + step * 2, ... are read until count pixels have
+        //! been read. Luminance is copied to RGB, and alpha is one for images
+        //! without alpha. YUV is converted to RGB with the video levels and
+        //! coefficients of the image. Nothing is read if the image type is
+        //! not readable.
+        void readPixels(
+            const std::shared_ptr<ftk::Image>&,
+            int x,
+            int y,
+            int count,
+            int step,
+            float* out);
+
+        //! Image statistics.
+        //!
+        //! The minimum, maximum, and mean are for each RGBA channel, and do
+        //! not include NaN or infinite values. The NaN, infinity, and negative
+        //! counts are the number of pixels with at least one channel that is
+        //! NaN, infinite, or negative.
+        struct ImageStats
+        {
+            ftk::Color4F min;
+            ftk::Color4F max;
+            ftk::Color4F mean;
+            size_t pixelCount = 0;
+            size_t nanCount = 0;
+            size_t infCount = 0;
+            size_t negativeCount = 0;
+
+            bool operator == (const ImageStats&) const;
+            bool operator != (const ImageStats&) const;
+        };
+
+        //! Get the statistics of an image. The rows are divided between
+        //! threads.
+        ImageStats getImageStats(const std::shared_ptr<ftk::Image>&);
+    }
+}
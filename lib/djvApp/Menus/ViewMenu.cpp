@@ -32,6 +32,7 @@ namespace djv
             addDivider();
             addAction(actions["Grid"]);
             addAction(actions["HUD"]);
+            addAction(actions["HUDGraph"]);
         }
 
         ViewMenu::~ViewMenu()
@@ -0,0 +1,383 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djvApp/Models/ExportModel.h>
+
+#include <tlTimeline/Util.h>
+
+#include <ftk/GL/Window.h>
+#include <ftk/Core/Context.h>
+#include <ftk/Core/Format.h>
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+
+namespace djv
+{
+    namespace app
+    {
+        namespace
+        {
+            const size_t videoRequestsMax = 2;
+            const std::chrono::milliseconds tickTimeout(1);
+
+            ExportJob* findJob(std::vector<ExportJob>& jobs, uint64_t id)
+            {
+                const auto i = std::find_if(
+                    jobs.begin(),
+                    jobs.end(),
+                    [id](const ExportJob& job)
+                    {
+                        return id == job.id;
+                    });
+                return i != jobs.end() ? &*i : nullptr;
+            }
+        }
+
+        FTK_ENUM_IMPL(
+            ExportJobStatus,
+            "Queued",
+            "Running",
+            "Finished",
+            "Canceled",
+            "Error");
+
+        bool ExportJob::operator == (const ExportJob& other) const
+        {
+            return
+                id == other.id &&
+                path == other.path &&
+                outputs == other.outputs &&
+                status == other.status &&
+                frameCount == other.frameCount &&
+                frameTotal == other.frameTotal &&
+                timings == other.timings &&
+                error == other.error;
+        }
+
+        bool ExportJob::operator != (const ExportJob& other) const
+        {
+            return !(*this == other);
+        }
+
+        struct ExportModel::Private
+        {
+            std::weak_ptr<ftk::Context> context;
+            std::shared_ptr<ftk::ObservableList<ExportJob> > jobs;
+            uint64_t id = 0;
+            std::shared_ptr<ftk::gl::Window> window;
+
+            struct JobData
+            {
+                uint64_t id = 0;
+                tl::file::Path path;
+                tl::file::Path audioPath;
+                tl::timeline::Options timelineOptions;
+                ExportOptions options;
+            };
+
+            struct Mutex
+            {
+                std::list<JobData> queue;
+                std::vector<ExportJob> jobs;
+                uint64_t current = 0;
+                bool cancel = false;
+                bool stopped = false;
+                std::mutex mutex;
+            };
+            Mutex mutex;
+            std::condition_variable cv;
+            std::thread thread;
+        };
+
+        void ExportModel::_init(const std::shared_ptr<ftk::Context>& context)
+        {
+            FTK_P();
+            p.context = context;
+            p.jobs = ftk::ObservableList<ExportJob>::create();
+        }
+
+        ExportModel::ExportModel() :
+            _p(new Private)
+        {}
+
+        ExportModel::~ExportModel()
+        {
+            FTK_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.stopped = true;
+            }
+            p.cv.notify_one();
+            if (p.thread.joinable())
+            {
+                p.thread.join();
+            }
+            p.window.reset();
+        }
+
+        std::shared_ptr<ExportModel> ExportModel::create(const std::shared_ptr<ftk::Context>& context)
+        {
+            auto out = std::shared_ptr<ExportModel>(new ExportModel);
+            out->_init(context);
+            return out;
+        }
+
+        const std::vector<ExportJob>& ExportModel::getJobs() const
+        {
+            return _p->jobs->get();
+        }
+
+        std::shared_ptr<ftk::IObservableList<ExportJob> > ExportModel::observeJobs() const
+        {
+            return _p->jobs;
+        }
+
+        uint64_t ExportModel::add(
+            const tl::file::Path& path,
+            const tl::file::Path& audioPath,
+            const tl::timeline::Options& timelineOptions,
+            const ExportOptions& options)
+        {
+            FTK_P();
+
+            // The window and thread are created with the first job. The
+            // window is only used for its OpenGL context, which is made
+            // current on the thread.
+            //
+            // GLFW requires windows to be created on the main thread, and a
+            // context can only be current on one thread at a time. Creating
+            // the window may make its context current on this thread, so it
+            // is explicitly released and the caller's context is restored
+            // before the thread starts. After that the new context is only
+            // ever current on the export thread, which releases it before
+            // exiting. The thread is joined before the window is destroyed.
+            if (!p.window)
+            {
+                if (auto context = p.context.lock())
+                {
+                    GLFWwindow* callerContext = glfwGetCurrentContext();
+                    p.window = ftk::gl::Window::create(
+                        context,
+                        "djv::app::ExportModel",
+                        ftk::Size2I(1, 1),
+                        static_cast<int>(ftk::gl::WindowOptions::None));
+                    p.window->doneCurrent();
+                    glfwMakeContextCurrent(callerContext);
+                    p.thread = std::thread(
+                        [this]
+                        {
+                            _run();
+                        });
+                }
+            }
+
+            Private::JobData data;
+            data.id = ++p.id;
+            data.path = path;
+            data.audioPath = audioPath;
+            data.timelineOptions = timelineOptions;
+            data.options = options;
+            const size_t writeThreadsMax = std::max(
+                static_cast<size_t>(1),
+                static_cast<size_t>(std::thread::hardware_concurrency() / 4));
+            data.options.videoRequests = std::min(data.options.videoRequests, videoRequestsMax);
+            for (auto& output : data.options.outputs)
+            {
+                output.writeThreads = std::min(output.writeThreads, writeThreadsMax);
+            }
+
+            ExportJob job;
+            job.id = data.id;
+            job.path = path;
+            for (const auto& output : options.outputs)
+            {
+                job.outputs.push_back(getExportPath(output, getExportRange(output, options)));
+            }
+            job.frameTotal = getFrames(options.range, options.shard).size();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.queue.push_back(data);
+                p.mutex.jobs.push_back(job);
+            }
+            p.cv.notify_one();
+            tick();
+            return data.id;
+        }
+
+        void ExportModel::remove(uint64_t id)
+        {
+            FTK_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                const auto i = std::find_if(
+                    p.mutex.queue.begin(),
+                    p.mutex.queue.end(),
+                    [id](const Private::JobData& data)
+                    {
+                        return id == data.id;
+                    });
+                if (i != p.mutex.queue.end())
+                {
+                    p.mutex.queue.erase(i);
+                }
+                if (id == p.mutex.current)
+                {
+                    p.mutex.cancel = true;
+                }
+                const auto j = std::find_if(
+                    p.mutex.jobs.begin(),
+                    p.mutex.jobs.end(),
+                    [id](const ExportJob& job)
+                    {
+                        return id == job.id;
+                    });
+                if (j != p.mutex.jobs.end())
+                {
+                    p.mutex.jobs.erase(j);
+                }
+            }
+            tick();
+        }
+
+        void ExportModel::clearFinished()
+        {
+            FTK_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                const auto i = std::remove_if(
+                    p.mutex.jobs.begin(),
+                    p.mutex.jobs.end(),
+                    [](const ExportJob& job)
+                    {
+                        return
+                            job.status != ExportJobStatus::Queued &&
+                            job.status != ExportJobStatus::Running;
+                    });
+                p.mutex.jobs.erase(i, p.mutex.jobs.end());
+            }
+            tick();
+        }
+
+        void ExportModel::tick()
+        {
+            FTK_P();
+            std::vector<ExportJob> jobs;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                jobs = p.mutex.jobs;
+            }
+            p.jobs->setIfChanged(jobs);
+        }
+
+        void ExportModel::_run()
+        {
+            FTK_P();
+            p.window->makeCurrent();
+            while (true)
+            {
+                Private::JobData data;
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    p.cv.wait(
+                        lock,
+                        [this]
+                        {
+                            return
+                                !_p->mutex.queue.empty() ||
+                                _p->mutex.stopped;
+                        });
+                    if (p.mutex.stopped)
+                    {
+                        break;
+                    }
+                    data = p.mutex.queue.front();
+                    p.mutex.queue.pop_front();
+                    p.mutex.current = data.id;
+                    p.mutex.cancel = false;
+                    if (auto job = findJob(p.mutex.jobs, data.id))
+                    {
+                        job->status = ExportJobStatus::Running;
+                    }
+                }
+
+                ExportJobStatus status = ExportJobStatus::Finished;
+                std::string error;
+                auto context = p.context.lock();
+                try
+                {
+                    if (!context)
+                    {
+                        throw std::runtime_error("No context");
+                    }
+
+                    // Open a separate timeline for the job.
+                    auto otioTimeline = data.audioPath.isEmpty() ?
+                        tl::timeline::create(context, data.path, data.timelineOptions) :
+                        tl::timeline::create(context, data.path, data.audioPath, data.timelineOptions);
+                    auto timeline = tl::timeline::Timeline::create(
+                        context,
+                        otioTimeline,
+                        data.timelineOptions);
+
+                    // Run the export.
+                    auto exporter = Exporter::create(context, timeline, data.options);
+                    while (!exporter->isFinished())
+                    {
+                        {
+                            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                            if (p.mutex.cancel || p.mutex.stopped)
+                            {
+                                status = ExportJobStatus::Canceled;
+                                break;
+                            }
+                        }
+                        exporter->tick();
+                        {
+                            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                            if (auto job = findJob(p.mutex.jobs, data.id))
+                            {
+                                job->frameCount = exporter->getFrameCount();
+                                job->frameTotal = exporter->getFrameTotal();
+                                job->timings = exporter->getTimings();
+                            }
+                        }
+                        std::this_thread::sleep_for(tickTimeout);
+                    }
+                    if (ExportJobStatus::Finished == status)
+                    {
+                        context->log(
+                            "djv::app::ExportModel",
+                            ftk::Format("Export timings: {0}\n{1}").
+                                arg(data.path.get()).
+                                arg(getExportTimingsSummary(exporter->getTimings())));
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    status = ExportJobStatus::Error;
+                    error = e.what();
+                    if (context)
+                    {
+                        context->log("djv::app::ExportModel", error, ftk::LogType::Error);
+                    }
+                }
+
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.current = 0;
+                if (auto job = findJob(p.mutex.jobs, data.id))
+                {
+                    job->status = status;
+                    job->error = error;
+                }
+            }
+            p.window->doneCurrent();
+        }
+    }
+}
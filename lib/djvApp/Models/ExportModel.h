@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <djvApp/Exporter.h>
+
+#include <ftk/Core/ObservableList.h>
+
+namespace ftk
+{
+    class Context;
+}
+
+namespace djv
+{
+    namespace app
+    {
+        //! Export job status.
+        enum class ExportJobStatus
+        {
+            Queued,
+            Running,
+            Finished,
+            Canceled,
+            Error,
+
+            Count,
+            First = Queued
+        };
+        FTK_ENUM(ExportJobStatus);
+
+        //! Export job.
+        struct ExportJob
+        {
+            uint64_t id = 0;
+            tl::file::Path path;
+            std::vector<tl::file::Path> outputs;
+            ExportJobStatus status = ExportJobStatus::Queued;
+            int64_t frameCount = 0;
+            int64_t frameTotal = 0;
+            ExportTimings timings;
+            std::string error;
+
+            bool operator == (const ExportJob&) const;
+            bool operator != (const ExportJob&) const;
+        };
+
+        //! Export model.
+        //!
+        //! Export jobs are queued and run one at a time on a background
+        //! thread with a separate OpenGL context, so that reviewing can
+        //! continue while exporting. Each job opens its own timeline from a
+        //! snapshot of the file path, time range, and options. Jobs are
+        //! limited to a small number of video requests and writer threads
+        //! so that they do not compete with playback.
+        class ExportModel : public std::enable_shared_from_this<ExportModel>
+        {
+            FTK_NON_COPYABLE(ExportModel);
+
+        protected:
+            void _init(const std::shared_ptr<ftk::Context>&);
+
+            ExportModel();
+
+        public:
+            ~ExportModel();
+
+            //! Create a new model.
+            static std::shared_ptr<ExportModel> create(const std::shared_ptr<ftk::Context>&);
+
+            //! Get the jobs.
+            const std::vector<ExportJob>& getJobs() const;
+
+            //! Observe the jobs.
+            std::shared_ptr<ftk::IObservableList<ExportJob> > observeJobs() const;
+
+            //! Add a job. The job ID is returned.
+            uint64_t add(
+                const tl::file::Path& path,
+                const tl::file::Path& audioPath,
+                const tl::timeline::Options&,
+                const ExportOptions&);
+
+            //! Remove a job. Jobs that are running are canceled.
+            void remove(uint64_t id);
+
+            //! Remove the jobs that are not queued or running.
+            void clearFinished();
+
+            //! Update the jobs from the background thread.
+            void tick();
+
+        private:
+            void _run();
+
+            FTK_PRIVATE();
+        };
+    }
+}
@@ -4,17 +4,172 @@
 #include <djvApp/Models/FilesModel.h>
 
 #include <ftk/UI/Settings.h>
+#include <ftk/Core/Error.h>
 #include <ftk/Core/Math.h>
+#include <ftk/Core/String.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <map>
+#include <sstream>
+#include <unordered_map>
 
 namespace djv
 {
     namespace app
     {
+        FTK_ENUM_IMPL(
+            FilesModelLoad,
+            "Unloaded",
+            "Queued",
+            "Loading",
+            "Ready",
+            "Error");
+
+        FTK_ENUM_IMPL(
+            FilesModelLoadStage,
+            "None",
+            "Checking files",
+            "Probing",
+            "Reading the probe cache",
+            "Creating the timeline");
+
+        bool FilesModelLoadState::operator == (const FilesModelLoadState& other) const
+        {
+            return
+                status == other.status &&
+                stage == other.stage &&
+                error == other.error;
+        }
+
+        bool FilesModelLoadState::operator != (const FilesModelLoadState& other) const
+        {
+            return !(*this == other);
+        }
+
+        bool FileStamp::operator == (const FileStamp& other) const
+        {
+            return time == other.time && size == other.size;
+        }
+
+        bool FileStamp::operator != (const FileStamp& other) const
+        {
+            return !(*this == other);
+        }
+
+        namespace
+        {
+            FileStamp getFileStamp(const std::filesystem::path& path)
+            {
+                // Missing files have an empty stamp.
+                FileStamp out;
+                std::error_code ec;
+                const auto time = std::filesystem::last_write_time(path, ec);
+                if (!ec)
+                {
+                    out.time = time.time_since_epoch().count();
+                }
+                const uintmax_t size = std::filesystem::file_size(path, ec);
+                if (!ec)
+                {
+                    out.size = size;
+                }
+                return out;
+            }
+        }
+
+        std::vector<FileStamp> getFileStamps(const tl::file::Path& path)
+        {
+            std::vector<FileStamp> out;
+            if (path.isSequence())
+            {
+                // Image sequences are found by listing the directory, so
+                // that frames added or removed after the sequence was opened
+                // are also found. The directory itself is not stamped, since
+                // it also changes when unrelated files are added.
+                const std::string& directory = path.getDirectory();
+                const std::filesystem::path fsDirectory = std::filesystem::u8path(
+                    !directory.empty() ? directory : std::string("."));
+                std::map<int64_t, std::filesystem::path> frames;
+                std::error_code ec;
+                std::filesystem::directory_iterator i(fsDirectory, ec);
+                for (; !ec && i != std::filesystem::directory_iterator(); i.increment(ec))
+                {
+                    const tl::file::Path entry(i->path().filename().u8string());
+                    if (entry.getBaseName() == path.getBaseName() &&
+                        entry.getExtension() == path.getExtension() &&
+                        !entry.getNumber().empty() &&
+                        entry.getPadding() == path.getPadding())
+                    {
+                        frames[std::atoll(entry.getNumber().c_str())] = i->path();
+                    }
+                }
+                for (const auto& frame : frames)
+                {
+                    out.push_back(getFileStamp(frame.second));
+                }
+            }
+            else
+            {
+                out.push_back(getFileStamp(std::filesystem::u8path(path.get())));
+            }
+            return out;
+        }
+
+        FileStamp getProbeStamp(const tl::file::Path& path)
+        {
+            FileStamp out;
+            if (path.isSequence())
+            {
+                // The frame range of a sequence only changes when frames are
+                // added, removed, or renamed, which also changes the
+                // modification time of the directory.
+                const std::string& directory = path.getDirectory();
+                out = getFileStamp(std::filesystem::u8path(
+                    !directory.empty() ? directory : std::string(".")));
+                out.size = 0;
+            }
+            else
+            {
+                out = getFileStamp(std::filesystem::u8path(path.get()));
+            }
+            return out;
+        }
+
+        std::string getCanonicalPath(const tl::file::Path& path)
+        {
+            // Only the directory is made canonical, since the file name of
+            // an image sequence does not exist on disk.
+            const std::string& directory = path.getDirectory();
+            const std::string fileName = path.get().substr(directory.size());
+            std::filesystem::path fsDirectory = std::filesystem::u8path(
+                !directory.empty() ? directory : std::string("."));
+            std::error_code ec;
+            const std::filesystem::path canonical = std::filesystem::weakly_canonical(
+                std::filesystem::absolute(fsDirectory, ec), ec);
+            if (!ec)
+            {
+                fsDirectory = canonical;
+            }
+            return (fsDirectory / std::filesystem::u8path(fileName)).u8string();
+        }
+
+        tl::io::Options getGenerationOptions(const FilesModelItem& item)
+        {
+            tl::io::Options out;
+            if (item.generation > 0)
+            {
+                out["DJV/Generation"] = std::to_string(item.generation);
+            }
+            return out;
+        }
+
         struct FilesModel::Private
         {
             std::shared_ptr<ftk::Settings> settings;
 
             std::shared_ptr<ftk::ObservableList<std::shared_ptr<FilesModelItem> > > files;
+            std::unordered_map<std::shared_ptr<FilesModelItem>, int> indexes;
             std::shared_ptr<ftk::ObservableValue<std::shared_ptr<FilesModelItem> > > a;
             std::shared_ptr<ftk::ObservableValue<int> > aIndex;
             std::shared_ptr<ftk::ObservableList<std::shared_ptr<FilesModelItem> > > b;
@@ -127,12 +282,26 @@ namespace djv
         }
 
         void FilesModel::add(const std::shared_ptr<FilesModelItem>& item)
+        {
+            add(std::vector<std::shared_ptr<FilesModelItem> >({ item }));
+        }
+
+        void FilesModel::add(const std::vector<std::shared_ptr<FilesModelItem> >& items)
         {
             FTK_P();
+            if (items.empty())
+                return;
 
-            p.files->pushBack(item);
+            auto files = p.files->get();
+            files.insert(files.end(), items.begin(), items.end());
+            p.indexes.reserve(files.size());
+            for (size_t i = files.size() - items.size(); i < files.size(); ++i)
+            {
+                p.indexes[files[i]] = static_cast<int>(i);
+            }
+            p.files->setIfChanged(files);
 
-            p.a->setIfChanged(p.files->getItem(p.files->getSize() - 1));
+            p.a->setIfChanged(files.back());
             p.aIndex->setIfChanged(_getIndex(p.a->get()));
 
             p.active->setIfChanged(_getActive());
@@ -157,6 +326,7 @@ namespace djv
                 const int aPrevIndex = _getIndex(p.a->get());
 
                 files.erase(files.begin() + index);
+                _indexesUpdate(files);
                 p.files->setIfChanged(files);
 
                 if (aPrevIndex == index)
@@ -170,8 +340,7 @@ namespace djv
                 auto j = b.begin();
                 while (j != b.end())
                 {
-                    const auto k = std::find(files.begin(), files.end(), *j);
-                    if (k == files.end())
+                    if (-1 == _getIndex(*j))
                     {
                         j = b.erase(j);
                     }
@@ -192,6 +361,7 @@ namespace djv
         {
             FTK_P();
 
+            p.indexes.clear();
             p.files->clear();
 
             p.a->setIfChanged(nullptr);
@@ -574,8 +744,19 @@ namespace djv
         int FilesModel::_getIndex(const std::shared_ptr<FilesModelItem>& item) const
         {
             FTK_P();
-            size_t index = p.files->indexOf(item);
-            return index != ftk::ObservableListInvalidIndex ? index : -1;
+            const auto i = p.indexes.find(item);
+            return i != p.indexes.end() ? i->second : -1;
+        }
+
+        void FilesModel::_indexesUpdate(const std::vector<std::shared_ptr<FilesModelItem> >& files)
+        {
+            FTK_P();
+            p.indexes.clear();
+            p.indexes.reserve(files.size());
+            for (size_t i = 0; i < files.size(); ++i)
+            {
+                p.indexes[files[i]] = static_cast<int>(i);
+            }
         }
 
         std::vector<int> FilesModel::_getBIndexes() const
@@ -626,6 +807,7 @@ namespace djv
         {
             FTK_P();
             std::vector<int> out;
+            out.reserve(p.files->getSize());
             for (const auto& f : p.files->get())
             {
                 out.push_back(f->videoLayer);
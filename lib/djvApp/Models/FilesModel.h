@@ -5,6 +5,8 @@
 
 #include <tlTimeline/CompareOptions.h>
 
+#include <tlIO/IO.h>
+
 #include <tlCore/Path.h>
 
 #include <ftk/Core/ObservableList.h>
@@ -19,12 +21,86 @@ namespace djv
 {
     namespace app
     {
+        //! Files model load status.
+        enum class FilesModelLoad
+        {
+            Unloaded,
+            Queued,
+            Loading,
+            Ready,
+            Error,
+
+            Count,
+            First = Unloaded
+        };
+        FTK_ENUM(FilesModelLoad);
+
+        //! Files model load stages.
+        enum class FilesModelLoadStage
+        {
+            None,
+            Stamps,
+            Probe,
+            ProbeCache,
+            Timeline,
+
+            Count,
+            First = None
+        };
+        FTK_ENUM(FilesModelLoadStage);
+
+        //! Files model load state.
+        struct FilesModelLoadState
+        {
+            FilesModelLoad status = FilesModelLoad::Unloaded;
+            FilesModelLoadStage stage = FilesModelLoadStage::None;
+            std::string error;
+
+            bool operator == (const FilesModelLoadState&) const;
+            bool operator != (const FilesModelLoadState&) const;
+        };
+
+        //! File modification time and size.
+        struct FileStamp
+        {
+            int64_t time = 0;
+            uintmax_t size = 0;
+
+            bool operator == (const FileStamp&) const;
+            bool operator != (const FileStamp&) const;
+        };
+
+        //! Get the modification times and sizes of the files for a path.
+        //! Image sequences have one stamp per frame found in the directory.
+        //! This is used to check for changes on reload.
+        std::vector<FileStamp> getFileStamps(const tl::file::Path&);
+
+        //! Get a stamp for the probe cache with a single file system call.
+        //! Image sequences use the modification time of the directory.
+        FileStamp getProbeStamp(const tl::file::Path&);
+
+        //! Get the absolute canonical form of a path.
+        std::string getCanonicalPath(const tl::file::Path&);
+
         //! Files model item.
         struct FilesModelItem
         {
             tl::file::Path path;
             tl::file::Path audioPath;
 
+            //! The timeline is only loaded while the file is active. The
+            //! layers and I/O information are kept when it is unloaded.
+            std::shared_ptr<ftk::ObservableValue<FilesModelLoadState> > load =
+                ftk::ObservableValue<FilesModelLoadState>::create();
+            tl::io::Info ioInfo;
+
+            //! The file stamps from when the file was loaded, used to check
+            //! for changes on reload. The generation is incremented when the
+            //! file has changed, so the cached data for the previous
+            //! generation is not used.
+            std::vector<FileStamp> stamps;
+            size_t generation = 0;
+
             std::vector<std::string> videoLayers;
             size_t videoLayer = 0;
 
@@ -33,6 +109,9 @@ namespace djv
             OTIO_NS::TimeRange inOutRange = tl::time::invalidTimeRange;
         };
 
+        //! Get the I/O options that identify the generation of a file.
+        tl::io::Options getGenerationOptions(const FilesModelItem&);
+
         //! Files model.
         class FilesModel : public std::enable_shared_from_this<FilesModel>
         {
@@ -91,6 +170,10 @@ namespace djv
             //! Add a file.
             void add(const std::shared_ptr<FilesModelItem>&);
 
+            //! Add multiple files. The observers are only notified once, and
+            //! the last file becomes the "A" file.
+            void add(const std::vector<std::shared_ptr<FilesModelItem> >&);
+
             //! Close the current "A" file.
             void close();
 
@@ -168,6 +251,7 @@ namespace djv
 
         private:
             int _getIndex(const std::shared_ptr<FilesModelItem>&) const;
+            void _indexesUpdate(const std::vector<std::shared_ptr<FilesModelItem> >&);
             std::vector<int> _getBIndexes() const;
             std::vector<std::shared_ptr<FilesModelItem> > _getActive() const;
             std::vector<int> _getLayers() const;
@@ -19,7 +19,13 @@ namespace djv
                 compat == other.compat &&
                 audioBufferFrameCount == other.audioBufferFrameCount &&
                 videoRequestMax == other.videoRequestMax &&
-                audioRequestMax == other.audioRequestMax;
+                audioRequestMax == other.audioRequestMax &&
+                timelineUnloadTimeout == other.timelineUnloadTimeout &&
+                standbyPlayer == other.standbyPlayer &&
+                standbyCacheGB == other.standbyCacheGB &&
+                playerPoolSize == other.playerPoolSize &&
+                probeCache == other.probeCache &&
+                probeCacheMB == other.probeCacheMB;
         }
 
         bool AdvancedSettings::operator != (const AdvancedSettings& other) const
@@ -66,7 +72,9 @@ namespace djv
                 imageExtension == other.imageExtension &&
                 movieBaseName == other.movieBaseName &&
                 movieExtension == other.movieExtension &&
-                movieCodec == other.movieCodec;
+                movieCodec == other.movieCodec &&
+                videoRequests == other.videoRequests &&
+                writeThreads == other.writeThreads;
         }
 
         bool ExportSettings::operator != (const ExportSettings& other) const
@@ -192,6 +200,8 @@ namespace djv
                 Shortcut("Tools/Settings", "Settings", ftk::Key::F9),
                 Shortcut("Tools/Messages", "Messages", ftk::Key::F10),
                 Shortcut("Tools/SystemLog", "System log", ftk::Key::F11),
+                Shortcut("Tools/Scopes", "Scopes", ftk::Key::F12),
+                Shortcut("Tools/Statistics", "Statistics"),
 
                 Shortcut("View/Frame", "Frame", ftk::Key::Backspace),
                 Shortcut("View/ZoomReset", "Zoom reset", ftk::Key::_0),
@@ -215,6 +225,7 @@ namespace djv
                 Shortcut("View/AlphaBlendPremultiplied", "Alpha blend premultiplied"),
                 Shortcut("View/Grid", "Grid", ftk::Key::G, static_cast<int>(ftk::KeyModifier::Control)),
                 Shortcut("View/HUD", "HUD", ftk::Key::H, static_cast<int>(ftk::KeyModifier::Control)),
+                Shortcut("View/HUDGraph", "HUD frame timing"),
 
                 Shortcut("Window/FullScreen", "Full screen", ftk::Key::U),
                 Shortcut("Window/FloatOnTop", "Float on top"),
@@ -386,6 +397,7 @@ namespace djv
             std::shared_ptr<ftk::ObservableValue<AdvancedSettings> > advanced;
             std::shared_ptr<ftk::ObservableValue<tl::timeline::PlayerCacheOptions> > cache;
             std::shared_ptr<ftk::ObservableValue<ExportSettings> > exportSettings;
+            std::shared_ptr<ftk::ObservableList<ExportSettings> > exportOutputs;
             std::shared_ptr<ftk::ObservableValue<FileBrowserSettings> > fileBrowser;
             std::shared_ptr<ftk::ObservableValue<ImageSequenceSettings> > imageSequence;
             std::shared_ptr<ftk::ObservableValue<ShortcutsSettings> > Shortcuts;
@@ -425,6 +437,10 @@ namespace djv
             settings->getT("/Export", exportSettings);
             p.exportSettings = ftk::ObservableValue<ExportSettings>::create(exportSettings);
 
+            std::vector<ExportSettings> exportOutputs;
+            settings->getT("/ExportOutputs", exportOutputs);
+            p.exportOutputs = ftk::ObservableList<ExportSettings>::create(exportOutputs);
+
             FileBrowserSettings fileBrowser;
             settings->getT("/FileBrowser", fileBrowser);
             p.fileBrowser = ftk::ObservableValue<FileBrowserSettings>::create(fileBrowser);
@@ -502,6 +518,7 @@ namespace djv
             p.settings->setT("/Advanced", p.advanced->get());
             p.settings->setT("/Cache", p.cache->get());
             p.settings->setT("/Export", p.exportSettings->get());
+            p.settings->setT("/ExportOutputs", p.exportOutputs->get());
 
             FileBrowserSettings fileBrowser = p.fileBrowser->get();
             if (auto context = p.context.lock())
@@ -537,6 +554,7 @@ namespace djv
             setAdvanced(AdvancedSettings());
             setCache(tl::timeline::PlayerCacheOptions());
             setExport(ExportSettings());
+            setExportOutputs({});
             setFileBrowser(FileBrowserSettings());
             setImageSequence(ImageSequenceSettings());
             setShortcuts(ShortcutsSettings());
@@ -602,6 +620,21 @@ namespace djv
             _p->exportSettings->setIfChanged(value);
         }
 
+        const std::vector<ExportSettings>& SettingsModel::getExportOutputs() const
+        {
+            return _p->exportOutputs->get();
+        }
+
+        std::shared_ptr<ftk::IObservableList<ExportSettings> > SettingsModel::observeExportOutputs() const
+        {
+            return _p->exportOutputs;
+        }
+
+        void SettingsModel::setExportOutputs(const std::vector<ExportSettings>& value)
+        {
+            _p->exportOutputs->setIfChanged(value);
+        }
+
         const FileBrowserSettings& SettingsModel::getFileBrowser() const
         {
             return _p->fileBrowser->get();
@@ -770,6 +803,12 @@ namespace djv
             json["AudioBufferFrameCount"] = value.audioBufferFrameCount;
             json["VideoRequestMax"] = value.videoRequestMax;
             json["AudioRequestMax"] = value.audioRequestMax;
+            json["TimelineUnloadTimeout"] = value.timelineUnloadTimeout;
+            json["StandbyPlayer"] = value.standbyPlayer;
+            json["StandbyCacheGB"] = value.standbyCacheGB;
+            json["PlayerPoolSize"] = value.playerPoolSize;
+            json["ProbeCache"] = value.probeCache;
+            json["ProbeCacheMB"] = value.probeCacheMB;
         }
 
         void to_json(nlohmann::json& json, const ExportSettings& value)
@@ -784,6 +823,8 @@ namespace djv
             json["MovieBaseName"] = value.movieBaseName;
             json["MovieExtension"] = value.movieExtension;
             json["MovieCodec"] = value.movieCodec;
+            json["VideoRequests"] = value.videoRequests;
+            json["WriteThreads"] = value.writeThreads;
         }
 
         void to_json(nlohmann::json& json, const FileBrowserSettings& value)
@@ -878,6 +919,12 @@ namespace djv
             json.at("AudioBufferFrameCount").get_to(value.audioBufferFrameCount);
             json.at("VideoRequestMax").get_to(value.videoRequestMax);
             json.at("AudioRequestMax").get_to(value.audioRequestMax);
+            json.at("TimelineUnloadTimeout").get_to(value.timelineUnloadTimeout);
+            json.at("StandbyPlayer").get_to(value.standbyPlayer);
+            json.at("StandbyCacheGB").get_to(value.standbyCacheGB);
+            json.at("PlayerPoolSize").get_to(value.playerPoolSize);
+            json.at("ProbeCache").get_to(value.probeCache);
+            json.at("ProbeCacheMB").get_to(value.probeCacheMB);
         }
 
         void from_json(const nlohmann::json& json, ExportSettings& value)
@@ -892,6 +939,8 @@ namespace djv
             json.at("MovieBaseName").get_to(value.movieBaseName);
             json.at("MovieExtension").get_to(value.movieExtension);
             json.at("MovieCodec").get_to(value.movieCodec);
+            json.at("VideoRequests").get_to(value.videoRequests);
+            json.at("WriteThreads").get_to(value.writeThreads);
         }
 
         void from_json(const nlohmann::json& json, FileBrowserSettings& value)
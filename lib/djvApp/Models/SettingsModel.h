@@ -11,6 +11,7 @@
 
 #include <ftk/UI/App.h>
 #include <ftk/UI/FileBrowser.h>
+#include <ftk/Core/ObservableList.h>
 #include <ftk/Core/ObservableValue.h>
 
 #include <tlIO/SequenceIO.h>
@@ -40,6 +41,12 @@ namespace djv
             size_t audioBufferFrameCount = tl::timeline::PlayerOptions().audioBufferFrameCount;
             size_t videoRequestMax = 16;
             size_t audioRequestMax = 16;
+            size_t timelineUnloadTimeout = 60;
+            bool standbyPlayer = false;
+            float standbyCacheGB = .5F;
+            size_t playerPoolSize = 0;
+            bool probeCache = true;
+            size_t probeCacheMB = 16;
 
             bool operator == (const AdvancedSettings&) const;
             bool operator != (const AdvancedSettings&) const;
@@ -90,6 +97,9 @@ namespace djv
             std::string movieExtension = ".mov";
             std::string movieCodec = "mjpeg";
 
+            size_t videoRequests = 4;
+            size_t writeThreads = 4;
+
             bool operator == (const ExportSettings&) const;
             bool operator != (const ExportSettings&) const;
         };
@@ -303,6 +313,12 @@ namespace djv
             std::shared_ptr<ftk::IObservableValue<ExportSettings> > observeExport() const;
             void setExport(const ExportSettings&);
 
+            //! Get the additional export outputs. The additional outputs
+            //! are exported together with the export settings.
+            const std::vector<ExportSettings>& getExportOutputs() const;
+            std::shared_ptr<ftk::IObservableList<ExportSettings> > observeExportOutputs() const;
+            void setExportOutputs(const std::vector<ExportSettings>&);
+
             ///@}
 
             //! \name File Browser
@@ -0,0 +1,360 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djvApp/Models/StatsModel.h>
+
+#include <tlTimeline/Util.h>
+
+#include <ftk/Core/Context.h>
+#include <ftk/Core/Error.h>
+#include <ftk/Core/Format.h>
+#include <ftk/Core/String.h>
+
+#include <nlohmann/json.hpp>
+
+#include <atomic>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace djv
+{
+    namespace app
+    {
+        namespace
+        {
+            const size_t videoRequestsMax = 4;
+            const std::chrono::milliseconds requestTimeout(5);
+        }
+
+        bool FrameStats::operator == (const FrameStats& other) const
+        {
+            return
+                time == other.time &&
+                stats == other.stats &&
+                error == other.error;
+        }
+
+        bool FrameStats::operator != (const FrameStats& other) const
+        {
+            return !(*this == other);
+        }
+
+        FTK_ENUM_IMPL(
+            StatsSweepStatus,
+            "None",
+            "Running",
+            "Finished",
+            "Canceled",
+            "Error");
+
+        bool StatsSweep::operator == (const StatsSweep& other) const
+        {
+            return
+                status == other.status &&
+                path == other.path &&
+                range == other.range &&
+                frameCount == other.frameCount &&
+                frameTotal == other.frameTotal &&
+                frameErrors == other.frameErrors &&
+                error == other.error;
+        }
+
+        bool StatsSweep::operator != (const StatsSweep& other) const
+        {
+            return !(*this == other);
+        }
+
+        void writeStatsReport(
+            const std::filesystem::path& fileName,
+            const tl::file::Path& path,
+            const std::vector<FrameStats>& frames)
+        {
+            std::ofstream file(fileName);
+            if (!file.is_open())
+            {
+                throw std::runtime_error(ftk::Format("Cannot open file: {0}").
+                    arg(fileName.u8string()));
+            }
+            if (ftk::compare(
+                fileName.extension().u8string(),
+                ".json",
+                ftk::CaseCompare::Insensitive))
+            {
+                nlohmann::json json;
+                json["path"] = path.get();
+                nlohmann::json jsonFrames = nlohmann::json::array();
+                for (const auto& frame : frames)
+                {
+                    const ImageStats& s = frame.stats;
+                    nlohmann::json jsonFrame;
+                    jsonFrame["frame"] = frame.time.to_frames();
+                    if (!frame.error.empty())
+                    {
+                        jsonFrame["error"] = frame.error;
+                        jsonFrames.push_back(jsonFrame);
+                        continue;
+                    }
+                    jsonFrame["min"] = { s.min.r, s.min.g, s.min.b, s.min.a };
+                    jsonFrame["max"] = { s.max.r, s.max.g, s.max.b, s.max.a };
+                    jsonFrame["mean"] = { s.mean.r, s.mean.g, s.mean.b, s.mean.a };
+                    jsonFrame["pixels"] = s.pixelCount;
+                    jsonFrame["nan"] = s.nanCount;
+                    jsonFrame["inf"] = s.infCount;
+                    jsonFrame["negative"] = s.negativeCount;
+                    jsonFrames.push_back(jsonFrame);
+                }
+                json["frames"] = jsonFrames;
+                file << json.dump(4);
+            }
+            else
+            {
+                file << "frame,"
+                    "min_r,min_g,min_b,min_a,"
+                    "max_r,max_g,max_b,max_a,"
+                    "mean_r,mean_g,mean_b,mean_a,"
+                    "pixels,nan,inf,negative,error\n";
+                for (const auto& frame : frames)
+                {
+                    file << frame.time.to_frames() << ',';
+                    if (!frame.error.empty())
+                    {
+                        // Leave the statistics empty so that the frame is
+                        // not mistaken for a black frame.
+                        std::string error = frame.error;
+                        size_t i = 0;
+                        while ((i = error.find('"', i)) != std::string::npos)
+                        {
+                            error.insert(i, 1, '"');
+                            i += 2;
+                        }
+                        file << std::string(16, ',') << '"' << error << "\"\n";
+                        continue;
+                    }
+                    const ImageStats& s = frame.stats;
+                    file <<
+                        s.min.r << ',' << s.min.g << ',' << s.min.b << ',' << s.min.a << ',' <<
+                        s.max.r << ',' << s.max.g << ',' << s.max.b << ',' << s.max.a << ',' <<
+                        s.mean.r << ',' << s.mean.g << ',' << s.mean.b << ',' << s.mean.a << ',' <<
+                        s.pixelCount << ',' <<
+                        s.nanCount << ',' <<
+                        s.infCount << ',' <<
+                        s.negativeCount << ",\n";
+                }
+            }
+            if (file.fail())
+            {
+                throw std::runtime_error(ftk::Format("Cannot write file: {0}").
+                    arg(fileName.u8string()));
+            }
+        }
+
+        struct StatsModel::Private
+        {
+            std::weak_ptr<ftk::Context> context;
+            std::shared_ptr<ftk::ObservableValue<StatsSweep> > sweep;
+
+            struct Mutex
+            {
+                StatsSweep sweep;
+                std::vector<FrameStats> frames;
+                std::mutex mutex;
+            };
+            Mutex mutex;
+            std::atomic<bool> cancel;
+            std::thread thread;
+        };
+
+        void StatsModel::_init(const std::shared_ptr<ftk::Context>& context)
+        {
+            FTK_P();
+            p.context = context;
+            p.sweep = ftk::ObservableValue<StatsSweep>::create();
+            p.cancel = false;
+        }
+
+        StatsModel::StatsModel() :
+            _p(new Private)
+        {}
+
+        StatsModel::~StatsModel()
+        {
+            _cancel();
+        }
+
+        std::shared_ptr<StatsModel> StatsModel::create(const std::shared_ptr<ftk::Context>& context)
+        {
+            auto out = std::shared_ptr<StatsModel>(new StatsModel);
+            out->_init(context);
+            return out;
+        }
+
+        const StatsSweep& StatsModel::getSweep() const
+        {
+            return _p->sweep->get();
+        }
+
+        std::shared_ptr<ftk::IObservableValue<StatsSweep> > StatsModel::observeSweep() const
+        {
+            return _p->sweep;
+        }
+
+        std::vector<FrameStats> StatsModel::getFrames() const
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            return p.mutex.frames;
+        }
+
+        void StatsModel::start(
+            const tl::file::Path& path,
+            const tl::file::Path& audioPath,
+            const tl::timeline::Options& timelineOptions,
+            const OTIO_NS::TimeRange& range,
+            int videoLayer)
+        {
+            FTK_P();
+            _cancel();
+
+            const int64_t frameTotal = range.duration().rescaled_to(range.start_time().rate()).value();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.sweep = StatsSweep();
+                p.mutex.sweep.status = StatsSweepStatus::Running;
+                p.mutex.sweep.path = path;
+                p.mutex.sweep.range = range;
+                p.mutex.sweep.frameTotal = frameTotal;
+                p.mutex.frames.clear();
+                p.mutex.frames.reserve(frameTotal);
+            }
+            p.cancel = false;
+            p.thread = std::thread(
+                [this, path, audioPath, timelineOptions, range, videoLayer, frameTotal]
+                {
+                    FTK_P();
+                    StatsSweepStatus status = StatsSweepStatus::Finished;
+                    std::string error;
+                    auto context = p.context.lock();
+                    try
+                    {
+                        if (!context)
+                        {
+                            throw std::runtime_error("No context");
+                        }
+
+                        // Open a separate timeline for the sweep.
+                        auto otioTimeline = audioPath.isEmpty() ?
+                            tl::timeline::create(context, path, timelineOptions) :
+                            tl::timeline::create(context, path, audioPath, timelineOptions);
+                        auto timeline = tl::timeline::Timeline::create(
+                            context,
+                            otioTimeline,
+                            timelineOptions);
+                        tl::io::Options ioOptions = timeline->getOptions().ioOptions;
+                        ioOptions["Layer"] = ftk::Format("{0}").arg(videoLayer);
+
+                        // Keep several requests in flight while the
+                        // statistics are computed.
+                        std::list<tl::timeline::VideoRequest> requests;
+                        int64_t next = 0;
+                        int64_t frameCount = 0;
+                        while (frameCount < frameTotal)
+                        {
+                            if (p.cancel)
+                            {
+                                status = StatsSweepStatus::Canceled;
+                                std::vector<uint64_t> ids;
+                                for (const auto& request : requests)
+                                {
+                                    ids.push_back(request.id);
+                                }
+                                timeline->cancelRequests(ids);
+                                break;
+                            }
+                            while (requests.size() < videoRequestsMax && next < frameTotal)
+                            {
+                                requests.push_back(timeline->getVideo(
+                                    range.start_time() + OTIO_NS::RationalTime(next, range.start_time().rate()),
+                                    ioOptions));
+                                ++next;
+                            }
+                            if (!requests.empty() &&
+                                requests.front().future.valid() &&
+                                requests.front().future.wait_for(requestTimeout) == std::future_status::ready)
+                            {
+                                const auto video = requests.front().future.get();
+                                requests.pop_front();
+                                FrameStats frame;
+                                frame.time = video.time;
+                                const auto image = !video.layers.empty() ?
+                                    video.layers.front().image :
+                                    nullptr;
+                                if (!image)
+                                {
+                                    frame.error = "Missing frame";
+                                }
+                                else if (!isReadable(image->getType()))
+                                {
+                                    frame.error = getUnreadableText(image->getType());
+                                }
+                                else
+                                {
+                                    frame.stats = getImageStats(image);
+                                }
+                                ++frameCount;
+                                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                                p.mutex.frames.push_back(frame);
+                                p.mutex.sweep.frameCount = frameCount;
+                                if (!frame.error.empty())
+                                {
+                                    ++p.mutex.sweep.frameErrors;
+                                }
+                            }
+                        }
+                    }
+                    catch (const std::exception& e)
+                    {
+                        status = StatsSweepStatus::Error;
+                        error = e.what();
+                        if (context)
+                        {
+                            context->log("djv::app::StatsModel", error, ftk::LogType::Error);
+                        }
+                    }
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    p.mutex.sweep.status = status;
+                    p.mutex.sweep.error = error;
+                });
+            tick();
+        }
+
+        void StatsModel::cancel()
+        {
+            _cancel();
+            tick();
+        }
+
+        void StatsModel::tick()
+        {
+            FTK_P();
+            StatsSweep sweep;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                sweep = p.mutex.sweep;
+            }
+            p.sweep->setIfChanged(sweep);
+        }
+
+        void StatsModel::_cancel()
+        {
+            FTK_P();
+            p.cancel = true;
+            if (p.thread.joinable())
+            {
+                p.thread.join();
+            }
+        }
+    }
+}
@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <djvApp/ImageUtil.h>
+
+#include <tlTimeline/Timeline.h>
+
+#include <ftk/Core/ObservableValue.h>
+
+#include <filesystem>
+
+namespace ftk
+{
+    class Context;
+}
+
+namespace djv
+{
+    namespace app
+    {
+        //! Frame statistics.
+        struct FrameStats
+        {
+            OTIO_NS::RationalTime time = tl::time::invalidTime;
+            ImageStats stats;
+
+            //! Set when the frame is missing or cannot be read, in which case
+            //! the statistics are not valid.
+            std::string error;
+
+            bool operator == (const FrameStats&) const;
+            bool operator != (const FrameStats&) const;
+        };
+
+        //! Statistics sweep status.
+        enum class StatsSweepStatus
+        {
+            None,
+            Running,
+            Finished,
+            Canceled,
+            Error,
+
+            Count,
+            First = None
+        };
+        FTK_ENUM(StatsSweepStatus);
+
+        //! Statistics sweep.
+        struct StatsSweep
+        {
+            StatsSweepStatus status = StatsSweepStatus::None;
+            tl::file::Path path;
+            OTIO_NS::TimeRange range = tl::time::invalidTimeRange;
+            int64_t frameCount = 0;
+            int64_t frameTotal = 0;
+            int64_t frameErrors = 0;
+            std::string error;
+
+            bool operator == (const StatsSweep&) const;
+            bool operator != (const StatsSweep&) const;
+        };
+
+        //! Write a statistics report. The report is written as JSON if the
+        //! file name has a ".json" extension, otherwise it is written as CSV.
+        //! Frames with an error are written with the error and without
+        //! statistics.
+        //! An exception is thrown if the file cannot be written.
+        void writeStatsReport(
+            const std::filesystem::path&,
+            const tl::file::Path&,
+            const std::vector<FrameStats>&);
+
+        //! Statistics model.
+        //!
+        //! The model sweeps a time range on a background thread and computes
+        //! the statistics of every frame. The sweep opens its own timeline
+        //! and keeps several video requests in flight, so that decoding the
+        //! next frames overlaps with computing the statistics of the current
+        //! one.
+        class StatsModel : public std::enable_shared_from_this<StatsModel>
+        {
+            FTK_NON_COPYABLE(StatsModel);
+
+        protected:
+            void _init(const std::shared_ptr<ftk::Context>&);
+
+            StatsModel();
+
+        public:
+            ~StatsModel();
+
+            //! Create a new model.
+            static std::shared_ptr<StatsModel> create(const std::shared_ptr<ftk::Context>&);
+
+            //! Get the sweep.
+            const StatsSweep& getSweep() const;
+
+            //! Observe the sweep.
+            std::shared_ptr<ftk::IObservableValue<StatsSweep> > observeSweep() const;
+
+            //! Get the frame statistics of the sweep.
+            std::vector<FrameStats> getFrames() const;
+
+            //! Start a sweep. A sweep that is running is canceled.
+            void start(
+                const tl::file::Path& path,
+                const tl::file::Path& audioPath,
+                const tl::timeline::Options&,
+                const OTIO_NS::TimeRange&,
+                int videoLayer);
+
+            //! Cancel the sweep.
+            void cancel();
+
+            //! Update the sweep from the background thread.
+            void tick();
+
+        private:
+            void _cancel();
+
+            FTK_PRIVATE();
+        };
+    }
+}
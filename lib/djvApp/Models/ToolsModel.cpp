@@ -23,6 +23,8 @@ namespace djv
             "View",
             "Color",
             "Color Picker",
+            "Scopes",
+            "Statistics",
             "Information",
             "Audio",
             "Devices",
@@ -40,6 +42,8 @@ namespace djv
                 "View",
                 "ColorControls",
                 "ColorPicker",
+                "",
+                "",
                 "Info",
                 "Audio",
                 "Devices",
@@ -24,6 +24,8 @@ namespace djv
             View,
             Color,
             ColorPicker,
+            Scopes,
+            Statistics,
             Info,
             Audio,
             Devices,
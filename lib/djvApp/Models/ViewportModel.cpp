@@ -5,21 +5,52 @@
 
 #include <ftk/UI/Settings.h>
 
+#include <algorithm>
+
 namespace djv
 {
     namespace app
     {
+        FTK_ENUM_IMPL(
+            ColorPickerMode,
+            "Display",
+            "Source",
+            "Both");
+
+        bool ColorPickerSample::operator == (const ColorPickerSample& other) const
+        {
+            return
+                color == other.color &&
+                min == other.min &&
+                max == other.max &&
+                size == other.size &&
+                source == other.source &&
+                sourcePos == other.sourcePos &&
+                sourceColor == other.sourceColor &&
+                sourceMin == other.sourceMin &&
+                sourceMax == other.sourceMax &&
+                sourceError == other.sourceError;
+        }
+
+        bool ColorPickerSample::operator != (const ColorPickerSample& other) const
+        {
+            return !(*this == other);
+        }
+
         struct ViewportModel::Private
         {
             std::weak_ptr<ftk::Context> context;
             std::shared_ptr<ftk::Settings> settings;
-            std::shared_ptr<ftk::ObservableValue<ftk::Color4F> > colorPicker;
+            std::shared_ptr<ftk::ObservableValue<ColorPickerSample> > colorPicker;
+            std::shared_ptr<ftk::ObservableValue<int> > colorPickerSize;
+            std::shared_ptr<ftk::ObservableValue<ColorPickerMode> > colorPickerMode;
             std::shared_ptr<ftk::ObservableValue<ftk::ImageOptions> > imageOptions;
             std::shared_ptr<ftk::ObservableValue<tl::timeline::DisplayOptions> > displayOptions;
             std::shared_ptr<ftk::ObservableValue<tl::timeline::BackgroundOptions> > backgroundOptions;
             std::shared_ptr<ftk::ObservableValue<tl::timeline::ForegroundOptions> > foregroundOptions;
             std::shared_ptr<ftk::ObservableValue<ftk::ImageType> > colorBuffer;
             std::shared_ptr<ftk::ObservableValue<bool> > hud;
+            std::shared_ptr<ftk::ObservableValue<bool> > hudGraph;
         };
 
         void ViewportModel::_init(
@@ -31,7 +62,17 @@ namespace djv
             p.context = context;
             p.settings = settings;
 
-            p.colorPicker = ftk::ObservableValue<ftk::Color4F>::create();
+            p.colorPicker = ftk::ObservableValue<ColorPickerSample>::create();
+
+            int colorPickerSize = 1;
+            p.settings->get("/Viewport/ColorPicker/Size", colorPickerSize);
+            p.colorPickerSize = ftk::ObservableValue<int>::create(colorPickerSize);
+
+            ColorPickerMode colorPickerMode = ColorPickerMode::Display;
+            std::string s = ftk::to_string(colorPickerMode);
+            p.settings->get("/Viewport/ColorPicker/Mode", s);
+            ftk::from_string(s, colorPickerMode);
+            p.colorPickerMode = ftk::ObservableValue<ColorPickerMode>::create(colorPickerMode);
 
             ftk::ImageOptions imageOptions;
             p.settings->getT("/Viewport/Image", imageOptions);
@@ -57,7 +98,7 @@ namespace djv
 #elif defined(FTK_API_GLES_2)
                 ftk::ImageType::RGBA_U8;
 #endif // FTK_API_GL_4_1
-            std::string s = ftk::to_string(colorBuffer);
+            s = ftk::to_string(colorBuffer);
             p.settings->get("/Viewport/ColorBuffer", s);
             ftk::from_string(s, colorBuffer);
             p.colorBuffer = ftk::ObservableValue<ftk::ImageType>::create(colorBuffer);
@@ -65,6 +106,10 @@ namespace djv
             bool hud = false;
             p.settings->get("/Viewport/HUD/Enabled", hud);
             p.hud = ftk::ObservableValue<bool>::create(hud);
+
+            bool hudGraph = false;
+            p.settings->get("/Viewport/HUD/Graph", hudGraph);
+            p.hudGraph = ftk::ObservableValue<bool>::create(hudGraph);
         }
 
         ViewportModel::ViewportModel() :
@@ -80,6 +125,9 @@ namespace djv
             p.settings->setT("/Viewport/Foreground", p.foregroundOptions->get());
             p.settings->set("/Viewport/ColorBuffer", ftk::to_string(p.colorBuffer->get()));
             p.settings->set("/Viewport/HUD/Enabled", p.hud->get());
+            p.settings->set("/Viewport/HUD/Graph", p.hudGraph->get());
+            p.settings->set("/Viewport/ColorPicker/Size", p.colorPickerSize->get());
+            p.settings->set("/Viewport/ColorPicker/Mode", ftk::to_string(p.colorPickerMode->get()));
         }
 
         std::shared_ptr<ViewportModel> ViewportModel::create(
@@ -91,21 +139,51 @@ namespace djv
             return out;
         }
 
-        const ftk::Color4F& ViewportModel::getColorPicker() const
+        const ColorPickerSample& ViewportModel::getColorPicker() const
         {
             return _p->colorPicker->get();
         }
 
-        std::shared_ptr<ftk::IObservableValue<ftk::Color4F> > ViewportModel::observeColorPicker() const
+        std::shared_ptr<ftk::IObservableValue<ColorPickerSample> > ViewportModel::observeColorPicker() const
         {
             return _p->colorPicker;
         }
 
-        void ViewportModel::setColorPicker(const ftk::Color4F& value)
+        void ViewportModel::setColorPicker(const ColorPickerSample& value)
         {
             _p->colorPicker->setIfChanged(value);
         }
 
+        int ViewportModel::getColorPickerSize() const
+        {
+            return _p->colorPickerSize->get();
+        }
+
+        std::shared_ptr<ftk::IObservableValue<int> > ViewportModel::observeColorPickerSize() const
+        {
+            return _p->colorPickerSize;
+        }
+
+        void ViewportModel::setColorPickerSize(int value)
+        {
+            _p->colorPickerSize->setIfChanged(std::max(1, value));
+        }
+
+        ColorPickerMode ViewportModel::getColorPickerMode() const
+        {
+            return _p->colorPickerMode->get();
+        }
+
+        std::shared_ptr<ftk::IObservableValue<ColorPickerMode> > ViewportModel::observeColorPickerMode() const
+        {
+            return _p->colorPickerMode;
+        }
+
+        void ViewportModel::setColorPickerMode(ColorPickerMode value)
+        {
+            _p->colorPickerMode->setIfChanged(value);
+        }
+
         const ftk::ImageOptions& ViewportModel::getImageOptions() const
         {
             return _p->imageOptions->get();
@@ -197,5 +275,20 @@ namespace djv
         {
             _p->hud->setIfChanged(value);
         }
+
+        bool ViewportModel::getHUDGraph() const
+        {
+            return _p->hudGraph->get();
+        }
+
+        std::shared_ptr<ftk::IObservableValue<bool> > ViewportModel::observeHUDGraph() const
+        {
+            return _p->hudGraph;
+        }
+
+        void ViewportModel::setHUDGraph(bool value)
+        {
+            _p->hudGraph->setIfChanged(value);
+        }
     }
 }
@@ -19,6 +19,42 @@ namespace djv
 {
     namespace app
     {
+        //! Color picker modes.
+        //!
+        //! The display mode reads the rendered viewport, after the color
+        //! pipeline. The source mode reads the decoded image in memory at
+        //! full precision, before the color pipeline, without a GPU readback.
+        enum class ColorPickerMode
+        {
+            Display,
+            Source,
+            Both,
+
+            Count,
+            First = Display
+        };
+        FTK_ENUM(ColorPickerMode);
+
+        //! Color picker sample. The colors are the averages of the sample
+        //! area.
+        struct ColorPickerSample
+        {
+            ftk::Color4F color;
+            ftk::Color4F min;
+            ftk::Color4F max;
+            int size = 1;
+
+            bool source = false;
+            ftk::V2I sourcePos;
+            ftk::Color4F sourceColor;
+            ftk::Color4F sourceMin;
+            ftk::Color4F sourceMax;
+            std::string sourceError;
+
+            bool operator == (const ColorPickerSample&) const;
+            bool operator != (const ColorPickerSample&) const;
+        };
+
         //! Viewport model.
         class ViewportModel : public std::enable_shared_from_this<ViewportModel>
         {
@@ -40,13 +76,31 @@ namespace djv
                 const std::shared_ptr<ftk::Settings>&);
 
             //! Get the color picker.
-            const ftk::Color4F& getColorPicker() const;
+            const ColorPickerSample& getColorPicker() const;
 
             //! Observe the color picker.
-            std::shared_ptr<ftk::IObservableValue<ftk::Color4F> > observeColorPicker() const;
+            std::shared_ptr<ftk::IObservableValue<ColorPickerSample> > observeColorPicker() const;
 
             //! Set the color picker.
-            void setColorPicker(const ftk::Color4F&);
+            void setColorPicker(const ColorPickerSample&);
+
+            //! Get the color picker sample area size.
+            int getColorPickerSize() const;
+
+            //! Observe the color picker sample area size.
+            std::shared_ptr<ftk::IObservableValue<int> > observeColorPickerSize() const;
+
+            //! Set the color picker sample area size.
+            void setColorPickerSize(int);
+
+            //! Get the color picker mode.
+            ColorPickerMode getColorPickerMode() const;
+
+            //! Observe the color picker mode.
+            std::shared_ptr<ftk::IObservableValue<ColorPickerMode> > observeColorPickerMode() const;
+
+            //! Set the color picker mode.
+            void setColorPickerMode(ColorPickerMode);
 
             //! Get the image options.
             const ftk::ImageOptions& getImageOptions() const;
@@ -102,6 +156,15 @@ namespace djv
             //! Set whether the HUD is enabled.
             void setHUD(bool);
 
+            //! Get whether the HUD frame timing graph is enabled.
+            bool getHUDGraph() const;
+
+            //! Observe whether the HUD frame timing graph is enabled.
+            std::shared_ptr<ftk::IObservableValue<bool> > observeHUDGraph() const;
+
+            //! Set whether the HUD frame timing graph is enabled.
+            void setHUDGraph(bool);
+
         private:
             FTK_PRIVATE();
         };
@@ -0,0 +1,342 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djvApp/ProbeCache.h>
+
+#include <ftk/Core/Context.h>
+#include <ftk/Core/Format.h>
+
+#include <nlohmann/json.hpp>
+
+#include <condition_variable>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <random>
+#include <thread>
+
+namespace djv
+{
+    namespace app
+    {
+        namespace
+        {
+            // Wait for this long after the last change before writing the
+            // cache, so that opening many files writes it once.
+            const std::chrono::seconds saveDelay(2);
+
+            struct Entry
+            {
+                std::string key;
+                int64_t time = 0;
+                uintmax_t size = 0;
+                size_t count = 0;
+                std::string timeline;
+            };
+
+            // Combine the stamps of an image sequence into a single stamp.
+            Entry getEntry(const std::string& key, const std::vector<FileStamp>& stamps)
+            {
+                Entry out;
+                out.key = key;
+                for (const auto& stamp : stamps)
+                {
+                    out.time = std::max(out.time, stamp.time);
+                    out.size += stamp.size;
+                }
+                out.count = stamps.size();
+                return out;
+            }
+        }
+
+        struct ProbeCache::Private
+        {
+            std::weak_ptr<ftk::Context> context;
+            std::filesystem::path path;
+
+            std::mutex mutex;
+            std::mutex saveMutex;
+            bool enabled = true;
+            size_t max = 16 * 1024 * 1024;
+            std::list<Entry> entries;
+            size_t size = 0;
+            bool changed = false;
+            std::chrono::steady_clock::time_point changedTime;
+            bool running = true;
+            std::condition_variable cv;
+            std::thread saveThread;
+        };
+
+        void ProbeCache::_init(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::filesystem::path& path)
+        {
+            FTK_P();
+            p.context = context;
+            p.path = path;
+            try
+            {
+                std::ifstream file(path);
+                if (file.is_open())
+                {
+                    const nlohmann::json json = nlohmann::json::parse(file);
+                    for (const auto& i : json.at("Entries"))
+                    {
+                        Entry entry;
+                        i.at("Key").get_to(entry.key);
+                        i.at("Time").get_to(entry.time);
+                        i.at("Size").get_to(entry.size);
+                        i.at("Count").get_to(entry.count);
+                        i.at("Timeline").get_to(entry.timeline);
+                        p.size += entry.timeline.size();
+                        p.entries.push_back(entry);
+                    }
+                }
+            }
+            catch (const std::exception& e)
+            {
+                p.entries.clear();
+                p.size = 0;
+                context->log(
+                    "djv::app::ProbeCache",
+                    ftk::Format("Cannot read the probe cache: {0}: {1}").
+                        arg(path.u8string()).
+                        arg(e.what()),
+                    ftk::LogType::Warning);
+            }
+
+            p.saveThread = std::thread(
+                [this]
+                {
+                    FTK_P();
+                    while (true)
+                    {
+                        {
+                            std::unique_lock<std::mutex> lock(p.mutex);
+                            p.cv.wait(
+                                lock,
+                                [this] { return !_p->running || _p->changed; });
+                            if (!p.running)
+                                break;
+                            // Wait until there have been no changes for the
+                            // save delay.
+                            while (p.running &&
+                                std::chrono::steady_clock::now() < p.changedTime + saveDelay)
+                            {
+                                p.cv.wait_until(lock, p.changedTime + saveDelay);
+                            }
+                            if (!p.running)
+                                break;
+                        }
+                        save();
+                    }
+                });
+        }
+
+        ProbeCache::ProbeCache() :
+            _p(new Private)
+        {}
+
+        ProbeCache::~ProbeCache()
+        {
+            FTK_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.running = false;
+            }
+            p.cv.notify_one();
+            if (p.saveThread.joinable())
+            {
+                p.saveThread.join();
+            }
+            save();
+        }
+
+        std::shared_ptr<ProbeCache> ProbeCache::create(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::filesystem::path& path)
+        {
+            auto out = std::shared_ptr<ProbeCache>(new ProbeCache);
+            out->_init(context, path);
+            return out;
+        }
+
+        void ProbeCache::setEnabled(bool value)
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.enabled = value;
+        }
+
+        void ProbeCache::setMax(size_t value)
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.max = value;
+            _trim();
+            lock.unlock();
+            p.cv.notify_one();
+        }
+
+        OTIO_NS::SerializableObject::Retainer<OTIO_NS::Timeline> ProbeCache::get(
+            const std::string& key,
+            const std::vector<FileStamp>& stamps)
+        {
+            FTK_P();
+            OTIO_NS::SerializableObject::Retainer<OTIO_NS::Timeline> out;
+            const Entry entry = getEntry(key, stamps);
+            std::string timeline;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                if (p.enabled)
+                {
+                    for (auto i = p.entries.begin(); i != p.entries.end(); ++i)
+                    {
+                        if (i->key == entry.key)
+                        {
+                            if (i->time == entry.time &&
+                                i->size == entry.size &&
+                                i->count == entry.count)
+                            {
+                                // Move the entry to the front of the list.
+                                timeline = i->timeline;
+                                p.entries.splice(p.entries.begin(), p.entries, i);
+                            }
+                            break;
+                        }
+                    }
+                }
+            }
+            if (!timeline.empty())
+            {
+                OTIO_NS::ErrorStatus errorStatus;
+                OTIO_NS::SerializableObject::Retainer<OTIO_NS::SerializableObject> object(
+                    OTIO_NS::SerializableObject::from_json_string(timeline, &errorStatus));
+                if (auto otioTimeline = dynamic_cast<OTIO_NS::Timeline*>(object.value))
+                {
+                    out = otioTimeline;
+                }
+            }
+            return out;
+        }
+
+        void ProbeCache::add(
+            const std::string& key,
+            const std::vector<FileStamp>& stamps,
+            const OTIO_NS::SerializableObject::Retainer<OTIO_NS::Timeline>& timeline)
+        {
+            FTK_P();
+            Entry entry = getEntry(key, stamps);
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                if (!p.enabled)
+                    return;
+            }
+            OTIO_NS::ErrorStatus errorStatus;
+            entry.timeline = timeline.value->to_json_string(&errorStatus, nullptr, 0);
+            if (OTIO_NS::is_error(errorStatus))
+                return;
+            std::unique_lock<std::mutex> lock(p.mutex);
+            for (auto i = p.entries.begin(); i != p.entries.end(); ++i)
+            {
+                if (i->key == entry.key)
+                {
+                    p.size -= i->timeline.size();
+                    p.entries.erase(i);
+                    break;
+                }
+            }
+            p.size += entry.timeline.size();
+            p.entries.push_front(std::move(entry));
+            _changed();
+            _trim();
+            lock.unlock();
+            p.cv.notify_one();
+        }
+
+        void ProbeCache::clear()
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.entries.clear();
+            p.size = 0;
+            _changed();
+            lock.unlock();
+            p.cv.notify_one();
+        }
+
+        void ProbeCache::save()
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> saveLock(p.saveMutex);
+            nlohmann::json json;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                if (!p.changed)
+                    return;
+                p.changed = false;
+                nlohmann::json entries = nlohmann::json::array();
+                for (const auto& entry : p.entries)
+                {
+                    entries.push_back({
+                        { "Key", entry.key },
+                        { "Time", entry.time },
+                        { "Size", entry.size },
+                        { "Count", entry.count },
+                        { "Timeline", entry.timeline } });
+                }
+                json["Entries"] = entries;
+            }
+
+            // Write to a temporary file and rename it, so that a partially
+            // written cache is never read. The temporary file has a unique
+            // name, since other instances may be saving at the same time.
+            std::filesystem::path tmpPath = p.path;
+            tmpPath += ftk::Format(".{0}.tmp").arg(std::random_device()());
+            bool written = false;
+            {
+                std::ofstream file(tmpPath);
+                if (file.is_open())
+                {
+                    file << json.dump();
+                    written = !file.fail();
+                }
+            }
+            std::error_code ec;
+            if (written)
+            {
+                std::filesystem::rename(tmpPath, p.path, ec);
+                written = !ec;
+            }
+            if (!written)
+            {
+                std::filesystem::remove(tmpPath, ec);
+                if (auto context = p.context.lock())
+                {
+                    context->log(
+                        "djv::app::ProbeCache",
+                        ftk::Format("Cannot write the probe cache: {0}").arg(p.path.u8string()),
+                        ftk::LogType::Warning);
+                }
+            }
+        }
+
+        void ProbeCache::_trim()
+        {
+            FTK_P();
+            while (p.size > p.max && !p.entries.empty())
+            {
+                p.size -= p.entries.back().timeline.size();
+                p.entries.pop_back();
+                _changed();
+            }
+        }
+
+        void ProbeCache::_changed()
+        {
+            FTK_P();
+            p.changed = true;
+            p.changedTime = std::chrono::steady_clock::now();
+        }
+    }
+}
@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <djvApp/Models/FilesModel.h>
+
+#include <opentimelineio/timeline.h>
+
+#include <filesystem>
+
+namespace ftk
+{
+    class Context;
+}
+
+namespace djv
+{
+    namespace app
+    {
+        //! Persistent cache of probed timelines.
+        //!
+        //! The cache stores the timelines created for media files, keyed by
+        //! the file path and the stamps from getProbeStamp(). Reopening a
+        //! file with a cached timeline skips the directory scan and the
+        //! header reads. The cache is written to disk on a background thread
+        //! shortly after timelines are added, and when it is destroyed. The
+        //! functions are thread safe.
+        class ProbeCache : public std::enable_shared_from_this<ProbeCache>
+        {
+            FTK_NON_COPYABLE(ProbeCache);
+
+        protected:
+            void _init(
+                const std::shared_ptr<ftk::Context>&,
+                const std::filesystem::path&);
+
+            ProbeCache();
+
+        public:
+            ~ProbeCache();
+
+            //! Create a new cache.
+            static std::shared_ptr<ProbeCache> create(
+                const std::shared_ptr<ftk::Context>&,
+                const std::filesystem::path&);
+
+            //! Set whether the cache is enabled.
+            void setEnabled(bool);
+
+            //! Set the maximum size of the cache in bytes.
+            void setMax(size_t);
+
+            //! Get a cached timeline. A null timeline is returned if the
+            //! timeline is not in the cache, or the files have changed.
+            OTIO_NS::SerializableObject::Retainer<OTIO_NS::Timeline> get(
+                const std::string& key,
+                const std::vector<FileStamp>&);
+
+            //! Add a timeline to the cache.
+            void add(
+                const std::string& key,
+                const std::vector<FileStamp>&,
+                const OTIO_NS::SerializableObject::Retainer<OTIO_NS::Timeline>&);
+
+            //! Clear the cache.
+            void clear();
+
+            //! Write the cache to disk.
+            void save();
+
+        private:
+            void _trim();
+            void _changed();
+
+            FTK_PRIVATE();
+        };
+    }
+}
@@ -0,0 +1,313 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djvApp/Process.h>
+
+#include <ftk/Core/Format.h>
+
+#include <stdexcept>
+
+#if defined(_WINDOWS)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <windows.h>
+#else // _WINDOWS
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+extern char** environ;
+#endif // _WINDOWS
+
+namespace djv
+{
+    namespace app
+    {
+        namespace
+        {
+#if defined(_WINDOWS)
+            std::wstring toWide(const std::string& value)
+            {
+                std::wstring out;
+                if (!value.empty())
+                {
+                    const int size = MultiByteToWideChar(
+                        CP_UTF8, 0, value.data(), static_cast<int>(value.size()), nullptr, 0);
+                    out.resize(size);
+                    MultiByteToWideChar(
+                        CP_UTF8, 0, value.data(), static_cast<int>(value.size()), out.data(), size);
+                }
+                return out;
+            }
+
+            // Quote an argument so that it is parsed back into the same
+            // string by CommandLineToArgvW() and the C runtime. Backslashes
+            // are only special when they are followed by a quote.
+            std::wstring quote(const std::wstring& value)
+            {
+                if (!value.empty() && value.find_first_of(L" \t\n\v\"") == std::wstring::npos)
+                {
+                    return value;
+                }
+                std::wstring out = L"\"";
+                for (auto i = value.begin(); ; ++i)
+                {
+                    size_t backslashes = 0;
+                    while (i != value.end() && L'\\' == *i)
+                    {
+                        ++i;
+                        ++backslashes;
+                    }
+                    if (i == value.end())
+                    {
+                        out.append(backslashes * 2, L'\\');
+                        break;
+                    }
+                    else if (L'"' == *i)
+                    {
+                        out.append(backslashes * 2 + 1, L'\\');
+                        out.push_back(*i);
+                    }
+                    else
+                    {
+                        out.append(backslashes, L'\\');
+                        out.push_back(*i);
+                    }
+                }
+                out.push_back(L'"');
+                return out;
+            }
+#endif // _WINDOWS
+        }
+
+        struct Process::Private
+        {
+#if defined(_WINDOWS)
+            HANDLE process = nullptr;
+            HANDLE readPipe = nullptr;
+#else // _WINDOWS
+            pid_t pid = 0;
+            int readPipe = -1;
+#endif // _WINDOWS
+            std::string buffer;
+            bool waited = false;
+            int exitCode = 1;
+        };
+
+        void Process::_init(const std::vector<std::string>& args)
+        {
+            FTK_P();
+            if (args.empty())
+            {
+                throw std::runtime_error("No program to start");
+            }
+#if defined(_WINDOWS)
+            SECURITY_ATTRIBUTES securityAttributes;
+            securityAttributes.nLength = sizeof(SECURITY_ATTRIBUTES);
+            securityAttributes.bInheritHandle = TRUE;
+            securityAttributes.lpSecurityDescriptor = nullptr;
+            HANDLE writePipe = nullptr;
+            if (!CreatePipe(&p.readPipe, &writePipe, &securityAttributes, 0))
+            {
+                throw std::runtime_error("Cannot create a pipe");
+            }
+            SetHandleInformation(p.readPipe, HANDLE_FLAG_INHERIT, 0);
+
+            std::vector<std::wstring> quoted;
+            for (const auto& arg : args)
+            {
+                quoted.push_back(quote(toWide(arg)));
+            }
+            std::wstring commandLine;
+            for (size_t i = 0; i < quoted.size(); ++i)
+            {
+                if (i > 0)
+                {
+                    commandLine.push_back(L' ');
+                }
+                commandLine.append(quoted[i]);
+            }
+
+            STARTUPINFOW startupInfo;
+            ZeroMemory(&startupInfo, sizeof(STARTUPINFOW));
+            startupInfo.cb = sizeof(STARTUPINFOW);
+            startupInfo.dwFlags = STARTF_USESTDHANDLES;
+            startupInfo.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
+            startupInfo.hStdOutput = writePipe;
+            startupInfo.hStdError = GetStdHandle(STD_ERROR_HANDLE);
+            PROCESS_INFORMATION processInfo;
+            ZeroMemory(&processInfo, sizeof(PROCESS_INFORMATION));
+            const BOOL r = CreateProcessW(
+                nullptr,
+                commandLine.data(),
+                nullptr,
+                nullptr,
+                TRUE,
+                CREATE_NO_WINDOW,
+                nullptr,
+                nullptr,
+                &startupInfo,
+                &processInfo);
+            CloseHandle(writePipe);
+            if (!r)
+            {
+                CloseHandle(p.readPipe);
+                p.readPipe = nullptr;
+                throw std::runtime_error(ftk::Format("Cannot start: {0}").arg(args.front()));
+            }
+            CloseHandle(processInfo.hThread);
+            p.process = processInfo.hProcess;
+#else // _WINDOWS
+            int fds[2] = { -1, -1 };
+            if (pipe(fds) != 0)
+            {
+                throw std::runtime_error(ftk::Format("Cannot create a pipe: {0}").
+                    arg(std::strerror(errno)));
+            }
+            posix_spawn_file_actions_t actions;
+            posix_spawn_file_actions_init(&actions);
+            posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+            posix_spawn_file_actions_addclose(&actions, fds[0]);
+            posix_spawn_file_actions_addclose(&actions, fds[1]);
+            std::vector<char*> argv;
+            for (const auto& arg : args)
+            {
+                argv.push_back(const_cast<char*>(arg.c_str()));
+            }
+            argv.push_back(nullptr);
+            const int r = posix_spawnp(
+                &p.pid,
+                args.front().c_str(),
+                &actions,
+                nullptr,
+                argv.data(),
+                environ);
+            posix_spawn_file_actions_destroy(&actions);
+            close(fds[1]);
+            if (r != 0)
+            {
+                close(fds[0]);
+                throw std::runtime_error(ftk::Format("Cannot start: {0}: {1}").
+                    arg(args.front()).
+                    arg(std::strerror(r)));
+            }
+            p.readPipe = fds[0];
+#endif // _WINDOWS
+        }
+
+        Process::Process() :
+            _p(new Private)
+        {}
+
+        Process::~Process()
+        {
+            FTK_P();
+            wait();
+#if defined(_WINDOWS)
+            if (p.readPipe)
+            {
+                CloseHandle(p.readPipe);
+            }
+#else // _WINDOWS
+            if (p.readPipe != -1)
+            {
+                close(p.readPipe);
+            }
+#endif // _WINDOWS
+        }
+
+        std::shared_ptr<Process> Process::create(const std::vector<std::string>& args)
+        {
+            auto out = std::shared_ptr<Process>(new Process);
+            out->_init(args);
+            return out;
+        }
+
+        bool Process::readLine(std::string& out)
+        {
+            FTK_P();
+            while (true)
+            {
+                const size_t i = p.buffer.find('\n');
+                if (i != std::string::npos)
+                {
+                    out = p.buffer.substr(0, i);
+                    p.buffer.erase(0, i + 1);
+                    return true;
+                }
+                char buf[4096];
+#if defined(_WINDOWS)
+                DWORD count = 0;
+                if (!p.readPipe ||
+                    !ReadFile(p.readPipe, buf, sizeof(buf), &count, nullptr) ||
+                    0 == count)
+                {
+                    break;
+                }
+#else // _WINDOWS
+                ssize_t count = -1;
+                do
+                {
+                    count = read(p.readPipe, buf, sizeof(buf));
+                } while (-1 == count && EINTR == errno);
+                if (count <= 0)
+                {
+                    break;
+                }
+#endif // _WINDOWS
+                p.buffer.append(buf, count);
+            }
+            if (!p.buffer.empty())
+            {
+                out = p.buffer;
+                p.buffer.clear();
+                return true;
+            }
+            return false;
+        }
+
+        int Process::wait()
+        {
+            FTK_P();
+            if (!p.waited)
+            {
+                p.waited = true;
+#if defined(_WINDOWS)
+                if (p.process)
+                {
+                    WaitForSingleObject(p.process, INFINITE);
+                    DWORD exitCode = 1;
+                    if (GetExitCodeProcess(p.process, &exitCode))
+                    {
+                        p.exitCode = static_cast<int>(exitCode);
+                    }
+                    CloseHandle(p.process);
+                    p.process = nullptr;
+                }
+#else // _WINDOWS
+                if (p.pid > 0)
+                {
+                    int status = 0;
+                    pid_t r = -1;
+                    do
+                    {
+                        r = waitpid(p.pid, &status, 0);
+                    } while (-1 == r && EINTR == errno);
+                    if (r == p.pid && WIFEXITED(status))
+                    {
+                        p.exitCode = WEXITSTATUS(status);
+                    }
+                }
+#endif // _WINDOWS
+            }
+            return p.exitCode;
+        }
+    }
+}
@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <ftk/Core/Util.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace djv
+{
+    namespace app
+    {
+        //! Child process.
+        //!
+        //! The process is started from a list of arguments without going
+        //! through a shell, and its standard output is read through a pipe.
+        class Process : public std::enable_shared_from_this<Process>
+        {
+            FTK_NON_COPYABLE(Process);
+
+        protected:
+            void _init(const std::vector<std::string>& args);
+
+            Process();
+
+        public:
+            ~Process();
+
+            //! Create a new process. The first argument is the program. An
+            //! exception is thrown if the process cannot be started.
+            static std::shared_ptr<Process> create(const std::vector<std::string>& args);
+
+            //! Read a line from the standard output of the process. This
+            //! function blocks until a line is available, and returns false
+            //! when the output is closed.
+            bool readLine(std::string&);
+
+            //! Wait for the process to exit and get the exit code.
+            int wait();
+
+        private:
+            FTK_PRIVATE();
+        };
+    }
+}
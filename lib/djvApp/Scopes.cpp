@@ -0,0 +1,241 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djvApp/Scopes.h>
+
+#include <djvApp/ImageUtil.h>
+
+#include <ftk/Core/Error.h>
+#include <ftk/Core/String.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <sstream>
+#include <thread>
+
+namespace djv
+{
+    namespace app
+    {
+        FTK_ENUM_IMPL(
+            ScopeType,
+            "Histogram",
+            "Waveform",
+            "Parade",
+            "Vectorscope");
+
+        namespace
+        {
+            // Rec. 709 coefficients.
+            const float kr = .2126F;
+            const float kg = .7152F;
+            const float kb = .0722F;
+
+            inline int toBin(float value, int size)
+            {
+                return std::min(std::max(static_cast<int>(value * (size - 1) + .5F), 0), size - 1);
+            }
+
+            // Accumulate the bins for a range of source rows.
+            void accumulate(
+                const std::shared_ptr<ftk::Image>& image,
+                ScopeType type,
+                const ftk::Size2I& size,
+                int y0,
+                int y1,
+                int stepX,
+                int stepY,
+                std::vector<uint32_t>& bins)
+            {
+                const int w = image->getWidth();
+                const int count = (w + stepX - 1) / stepX;
+                std::vector<float> row(static_cast<size_t>(count) * 4);
+                const int paradeW = std::max(1, size.w / 3);
+                const int vectorSize = std::min(size.w, size.h);
+                const int vectorX = (size.w - vectorSize) / 2;
+                const int vectorY = (size.h - vectorSize) / 2;
+                for (int y = y0; y < y1; y += stepY)
+                {
+                    readPixels(image, 0, y, count, stepX, row.data());
+                    const float* p = row.data();
+                    for (int i = 0; i < count; ++i, p += 4)
+                    {
+                        const float luma = p[0] * kr + p[1] * kg + p[2] * kb;
+                        switch (type)
+                        {
+                        case ScopeType::Histogram:
+                            for (int c = 0; c < 3; ++c)
+                            {
+                                ++bins[c * size.w + toBin(p[c], size.w)];
+                            }
+                            ++bins[3 * size.w + toBin(luma, size.w)];
+                            break;
+                        case ScopeType::Waveform:
+                        {
+                            const int x = static_cast<int64_t>(i) * stepX * size.w / w;
+                            const int b = toBin(1.F - luma, size.h);
+                            ++bins[b * size.w + x];
+                            break;
+                        }
+                        case ScopeType::Parade:
+                        {
+                            const int x = static_cast<int64_t>(i) * stepX * paradeW / w;
+                            for (int c = 0; c < 3; ++c)
+                            {
+                                const int b = toBin(1.F - p[c], size.h);
+                                ++bins[b * size.w + std::min(c * paradeW + x, size.w - 1)];
+                            }
+                            break;
+                        }
+                        case ScopeType::Vectorscope:
+                        {
+                            const float cb = (p[2] - luma) / 1.8556F;
+                            const float cr = (p[0] - luma) / 1.5748F;
+                            const int x = vectorX + toBin(cb + .5F, vectorSize);
+                            const int b = vectorY + toBin(.5F - cr, vectorSize);
+                            ++bins[b * size.w + x];
+                            break;
+                        }
+                        default: break;
+                        }
+                    }
+                }
+            }
+
+            inline uint8_t add(uint8_t a, float b)
+            {
+                return std::min(255, a + static_cast<int>(b * 255.F));
+            }
+        }
+
+        std::shared_ptr<ftk::Image> getScope(
+            const std::shared_ptr<ftk::Image>& image,
+            ScopeType type,
+            const ftk::Size2I& size)
+        {
+            std::shared_ptr<ftk::Image> out;
+            if (!image || !isReadable(image->getType()) || !size.isValid())
+                return out;
+            const int w = image->getWidth();
+            const int h = image->getHeight();
+            if (w <= 0 || h <= 0)
+                return out;
+
+            // Decimate the source to the size of the scope.
+            const int stepX = std::max(1, w / size.w);
+            const int stepY = std::max(1, h / size.h);
+
+            // Divide the rows between threads. Each thread accumulates into
+            // its own bins which are summed at the end.
+            const size_t binCount = ScopeType::Histogram == type ?
+                static_cast<size_t>(size.w) * 4 :
+                static_cast<size_t>(size.w) * size.h;
+            const int rows = (h + stepY - 1) / stepY;
+            const int threadCount = std::max(1, std::min(
+                static_cast<int>(std::thread::hardware_concurrency()),
+                rows / 16));
+            const int rowsPerThread = (rows + threadCount - 1) / threadCount;
+            std::vector<std::vector<uint32_t> > bins(threadCount);
+            std::vector<std::future<void> > futures;
+            for (int i = 0; i < threadCount; ++i)
+            {
+                const int y0 = i * rowsPerThread * stepY;
+                const int y1 = std::min(h, (i + 1) * rowsPerThread * stepY);
+                auto& threadBins = bins[i];
+                threadBins.resize(binCount, 0);
+                if (0 == i)
+                    continue;
+                futures.push_back(std::async(
+                    std::launch::async,
+                    [image, type, size, y0, y1, stepX, stepY, &threadBins]
+                    {
+                        accumulate(image, type, size, y0, y1, stepX, stepY, threadBins);
+                    }));
+            }
+            accumulate(image, type, size, 0, std::min(h, rowsPerThread * stepY), stepX, stepY, bins[0]);
+            for (auto& future : futures)
+            {
+                future.get();
+            }
+            for (int i = 1; i < threadCount; ++i)
+            {
+                for (size_t j = 0; j < binCount; ++j)
+                {
+                    bins[0][j] += bins[i][j];
+                }
+            }
+            const std::vector<uint32_t>& total = bins[0];
+            const uint32_t max = *std::max_element(total.begin(), total.end());
+
+            // Draw the scope.
+            out = ftk::Image::create(size.w, size.h, ftk::ImageType::RGBA_U8);
+            uint8_t* data = out->getData();
+            memset(data, 0, out->getByteCount());
+            if (0 == max)
+                return out;
+            const float logMax = std::log1p(static_cast<float>(max));
+            switch (type)
+            {
+            case ScopeType::Histogram:
+            {
+                const std::array<std::array<float, 3>, 4> colors =
+                {
+                    std::array<float, 3>{ .6F, 0.F, 0.F },
+                    std::array<float, 3>{ 0.F, .6F, 0.F },
+                    std::array<float, 3>{ 0.F, 0.F, .6F },
+                    std::array<float, 3>{ .4F, .4F, .4F }
+                };
+                for (int c = 0; c < 4; ++c)
+                {
+                    for (int x = 0; x < size.w; ++x)
+                    {
+                        const int height = std::log1p(static_cast<float>(total[c * size.w + x])) /
+                            logMax * size.h;
+                        for (int y = size.h - height; y < size.h; ++y)
+                        {
+                            uint8_t* p = data + (static_cast<size_t>(y) * size.w + x) * 4;
+                            p[0] = add(p[0], colors[c][0]);
+                            p[1] = add(p[1], colors[c][1]);
+                            p[2] = add(p[2], colors[c][2]);
+                            p[3] = 255;
+                        }
+                    }
+                }
+                break;
+            }
+            default:
+            {
+                const int paradeW = std::max(1, size.w / 3);
+                for (int y = 0; y < size.h; ++y)
+                {
+                    for (int x = 0; x < size.w; ++x)
+                    {
+                        const uint32_t count = total[static_cast<size_t>(y) * size.w + x];
+                        if (0 == count)
+                            continue;
+                        const float v = std::log1p(static_cast<float>(count)) / logMax;
+                        uint8_t* p = data + (static_cast<size_t>(y) * size.w + x) * 4;
+                        if (ScopeType::Parade == type)
+                        {
+                            const int c = std::min(x / paradeW, 2);
+                            p[0] = 0 == c ? add(0, v) : add(0, v * .3F);
+                            p[1] = 1 == c ? add(0, v) : add(0, v * .3F);
+                            p[2] = 2 == c ? add(0, v) : add(0, v * .3F);
+                        }
+                        else
+                        {
+                            p[0] = p[1] = p[2] = add(0, v);
+                        }
+                        p[3] = 255;
+                    }
+                }
+                break;
+            }
+            }
+            return out;
+        }
+    }
+}
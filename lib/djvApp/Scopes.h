@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <ftk/Core/Image.h>
+
+namespace djv
+{
+    namespace app
+    {
+        //! Scope types.
+        enum class ScopeType
+        {
+            Histogram,
+            Waveform,
+            Parade,
+            Vectorscope,
+
+            Count,
+            First = Histogram
+        };
+        FTK_ENUM(ScopeType);
+
+        //! Create an image of a scope.
+        //!
+        //! The source image is decimated so that roughly one pixel is read
+        //! for each pixel of the scope, and the rows are divided between
+        //! threads. The scope is returned as an RGBA_U8 image of the given
+        //! size, or null if the source image type cannot be read.
+        std::shared_ptr<ftk::Image> getScope(
+            const std::shared_ptr<ftk::Image>&,
+            ScopeType,
+            const ftk::Size2I&);
+    }
+}
@@ -0,0 +1,235 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djvApp/StartupProfiler.h>
+
+#include <ftk/Core/Context.h>
+#include <ftk/Core/Format.h>
+
+#include <nlohmann/json.hpp>
+
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace djv
+{
+    namespace app
+    {
+        namespace
+        {
+            struct Event
+            {
+                std::string name;
+                std::string category;
+                std::string phase;
+                int64_t ts = 0;
+                int64_t dur = 0;
+                size_t tid = 0;
+            };
+
+            // Get a small sequential ID for a thread. The thread that
+            // creates the profiler is the first.
+            size_t getThreadID(
+                std::map<std::thread::id, size_t>& threads,
+                const std::thread::id& id)
+            {
+                const auto i = threads.find(id);
+                if (i != threads.end())
+                {
+                    return i->second;
+                }
+                const size_t out = threads.size() + 1;
+                threads[id] = out;
+                return out;
+            }
+        }
+
+        struct StartupProfiler::Private
+        {
+            std::chrono::steady_clock::time_point start;
+            std::filesystem::path fileName;
+
+            mutable std::mutex mutex;
+            std::map<std::thread::id, size_t> threads;
+            std::vector<Event> events;
+            bool finished = false;
+        };
+
+        StartupProfiler::StartupProfiler(const std::shared_ptr<ftk::Context>& context) :
+            ISystem(context, "djv::app::StartupProfiler"),
+            _p(new Private)
+        {
+            FTK_P();
+            p.start = std::chrono::steady_clock::now();
+            getThreadID(p.threads, std::this_thread::get_id());
+        }
+
+        StartupProfiler::~StartupProfiler()
+        {}
+
+        std::shared_ptr<StartupProfiler> StartupProfiler::create(
+            const std::shared_ptr<ftk::Context>& context)
+        {
+            auto out = context->getSystem<StartupProfiler>();
+            if (!out)
+            {
+                out = std::shared_ptr<StartupProfiler>(new StartupProfiler(context));
+                context->addSystem(out);
+            }
+            return out;
+        }
+
+        void StartupProfiler::setFileName(const std::filesystem::path& value)
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.fileName = value;
+        }
+
+        void StartupProfiler::addScope(
+            const std::string& name,
+            const std::string& category,
+            const std::chrono::steady_clock::time_point& start,
+            const std::chrono::steady_clock::time_point& end)
+        {
+            FTK_P();
+            Event event;
+            event.name = name;
+            event.category = category;
+            event.phase = "X";
+            event.ts = std::chrono::duration_cast<std::chrono::microseconds>(start - p.start).count();
+            event.dur = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            if (!p.finished)
+            {
+                event.tid = getThreadID(p.threads, std::this_thread::get_id());
+                p.events.push_back(event);
+            }
+        }
+
+        void StartupProfiler::addMark(const std::string& name, const std::string& category)
+        {
+            FTK_P();
+            Event event;
+            event.name = name;
+            event.category = category;
+            event.phase = "i";
+            event.ts = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - p.start).count();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            if (!p.finished)
+            {
+                event.tid = getThreadID(p.threads, std::this_thread::get_id());
+                p.events.push_back(event);
+            }
+        }
+
+        void StartupProfiler::finish()
+        {
+            FTK_P();
+            std::filesystem::path fileName;
+            std::vector<Event> events;
+            size_t threadCount = 0;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                if (p.finished)
+                    return;
+                p.finished = true;
+                fileName = p.fileName;
+                events = std::move(p.events);
+                threadCount = p.threads.size();
+            }
+            if (fileName.empty())
+                return;
+
+            // Add metadata events so the threads are named in the viewer.
+            nlohmann::json traceEvents = nlohmann::json::array();
+            for (size_t i = 1; i <= threadCount; ++i)
+            {
+                nlohmann::json json;
+                json["name"] = "thread_name";
+                json["ph"] = "M";
+                json["pid"] = 1;
+                json["tid"] = i;
+                json["args"]["name"] = 1 == i ?
+                    std::string("Main") :
+                    ftk::Format("Worker {0}").arg(i - 1).operator std::string();
+                traceEvents.push_back(json);
+            }
+            for (const auto& event : events)
+            {
+                nlohmann::json json;
+                json["name"] = event.name;
+                json["cat"] = event.category;
+                json["ph"] = event.phase;
+                json["ts"] = event.ts;
+                json["pid"] = 1;
+                json["tid"] = event.tid;
+                if ("X" == event.phase)
+                {
+                    json["dur"] = event.dur;
+                }
+                else
+                {
+                    json["s"] = "g";
+                }
+                traceEvents.push_back(json);
+            }
+            nlohmann::json json;
+            json["traceEvents"] = traceEvents;
+            json["displayTimeUnit"] = "ms";
+
+            std::ofstream file(fileName);
+            if (file.is_open())
+            {
+                file << json.dump(4);
+            }
+            else if (auto context = _context.lock())
+            {
+                context->log(
+                    _name,
+                    ftk::Format("Cannot write the startup profile: {0}").arg(fileName.u8string()),
+                    ftk::LogType::Error);
+            }
+        }
+
+        bool StartupProfiler::isFinished() const
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.finished;
+        }
+
+        StartupProfilerScope::StartupProfilerScope(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::string& name,
+            const std::string& category) :
+            _name(name),
+            _category(category)
+        {
+            if (context)
+            {
+                auto profiler = context->getSystem<StartupProfiler>();
+                if (profiler && !profiler->isFinished())
+                {
+                    _profiler = profiler;
+                    _start = std::chrono::steady_clock::now();
+                }
+            }
+        }
+
+        StartupProfilerScope::~StartupProfilerScope()
+        {
+            if (auto profiler = _profiler.lock())
+            {
+                profiler->addScope(
+                    _name,
+                    _category,
+                    _start,
+                    std::chrono::steady_clock::now());
+            }
+        }
+    }
+}
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <ftk/Core/ISystem.h>
+
+#include <chrono>
+#include <filesystem>
+
+namespace djv
+{
+    namespace app
+    {
+        //! Startup profiler.
+        //!
+        //! The profiler records timings from when it is created until the
+        //! first frame is displayed, and writes them as a Chrome trace JSON
+        //! file that can be viewed in Perfetto or chrome://tracing.
+        class StartupProfiler : public ftk::ISystem
+        {
+            FTK_NON_COPYABLE(StartupProfiler);
+
+        protected:
+            StartupProfiler(const std::shared_ptr<ftk::Context>&);
+
+        public:
+            virtual ~StartupProfiler();
+
+            //! Create a new system.
+            static std::shared_ptr<StartupProfiler> create(
+                const std::shared_ptr<ftk::Context>&);
+
+            //! Set the output file name. If the file name is empty the
+            //! trace is not written.
+            void setFileName(const std::filesystem::path&);
+
+            //! Add a scope.
+            void addScope(
+                const std::string& name,
+                const std::string& category,
+                const std::chrono::steady_clock::time_point& start,
+                const std::chrono::steady_clock::time_point& end);
+
+            //! Add a mark.
+            void addMark(const std::string& name, const std::string& category);
+
+            //! Stop recording and write the trace.
+            void finish();
+
+            //! Get whether recording has finished.
+            bool isFinished() const;
+
+        private:
+            FTK_PRIVATE();
+        };
+
+        //! Startup profiler scope. The scope is recorded when it is
+        //! destroyed. If there is no profiler in the context nothing is
+        //! recorded.
+        class StartupProfilerScope
+        {
+            FTK_NON_COPYABLE(StartupProfilerScope);
+
+        public:
+            StartupProfilerScope(
+                const std::shared_ptr<ftk::Context>&,
+                const std::string& name,
+                const std::string& category = "Startup");
+
+            ~StartupProfilerScope();
+
+        private:
+            std::weak_ptr<StartupProfiler> _profiler;
+            std::string _name;
+            std::string _category;
+            std::chrono::steady_clock::time_point _start;
+        };
+    }
+}
@@ -7,19 +7,46 @@
 #include <djvApp/App.h>
 
 #include <ftk/UI/ColorWidget.h>
+#include <ftk/UI/ComboBox.h>
+#include <ftk/UI/FormLayout.h>
+#include <ftk/UI/IntEdit.h>
 #include <ftk/UI/Label.h>
 #include <ftk/UI/RowLayout.h>
 #include <ftk/UI/ScrollWidget.h>
+#include <ftk/Core/Format.h>
 
 namespace djv
 {
     namespace app
     {
+        namespace
+        {
+            std::string getText(const ftk::Color4F& value)
+            {
+                return ftk::Format("{0} {1} {2} {3}").
+                    arg(value.r, 4).
+                    arg(value.g, 4).
+                    arg(value.b, 4).
+                    arg(value.a, 4);
+            }
+        }
+
         struct ColorPickerTool::Private
         {
             std::shared_ptr<ftk::ColorWidget> colorWidget;
+            std::shared_ptr<ftk::ComboBox> modeComboBox;
+            std::shared_ptr<ftk::IntEdit> sizeEdit;
+            std::shared_ptr<ftk::Label> minLabel;
+            std::shared_ptr<ftk::Label> maxLabel;
+            std::shared_ptr<ftk::Label> sourcePosLabel;
+            std::shared_ptr<ftk::Label> sourceColorLabel;
+            std::shared_ptr<ftk::Label> sourceMinLabel;
+            std::shared_ptr<ftk::Label> sourceMaxLabel;
+            std::shared_ptr<ftk::FormLayout> formLayout;
 
-            std::shared_ptr<ftk::ValueObserver<ftk::Color4F> > colorPickerObserver;
+            std::shared_ptr<ftk::ValueObserver<ColorPickerSample> > colorPickerObserver;
+            std::shared_ptr<ftk::ValueObserver<int> > sizeObserver;
+            std::shared_ptr<ftk::ValueObserver<ColorPickerMode> > modeObserver;
         };
 
         void ColorPickerTool::_init(
@@ -38,21 +65,127 @@ namespace djv
             p.colorWidget = ftk::ColorWidget::create(context);
             p.colorWidget->setColor(ftk::Color4F(0.F, 0.F, 0.F));
 
+            p.modeComboBox = ftk::ComboBox::create(context, getColorPickerModeLabels());
+            p.modeComboBox->setTooltip(
+                "Display samples the viewport after the color pipeline. Source "
+                "samples the decoded image before the color pipeline.");
+
+            p.sizeEdit = ftk::IntEdit::create(context);
+            p.sizeEdit->setRange(1, 64);
+            p.sizeEdit->setTooltip(
+                "Size of the area that is sampled. The color is the average "
+                "of the area.");
+
+            p.minLabel = ftk::Label::create(context);
+            p.minLabel->setFontRole(ftk::FontRole::Mono);
+            p.maxLabel = ftk::Label::create(context);
+            p.maxLabel->setFontRole(ftk::FontRole::Mono);
+            p.sourcePosLabel = ftk::Label::create(context);
+            p.sourcePosLabel->setFontRole(ftk::FontRole::Mono);
+            p.sourceColorLabel = ftk::Label::create(context);
+            p.sourceColorLabel->setFontRole(ftk::FontRole::Mono);
+            p.sourceMinLabel = ftk::Label::create(context);
+            p.sourceMinLabel->setFontRole(ftk::FontRole::Mono);
+            p.sourceMaxLabel = ftk::Label::create(context);
+            p.sourceMaxLabel->setFontRole(ftk::FontRole::Mono);
+
             auto layout = ftk::VerticalLayout::create(context);
             layout->setMarginRole(ftk::SizeRole::MarginSmall);
             layout->setSpacingRole(ftk::SizeRole::SpacingSmall);
             p.colorWidget->setParent(layout);
+            p.formLayout = ftk::FormLayout::create(context, layout);
+            p.formLayout->setSpacingRole(ftk::SizeRole::SpacingSmall);
+            p.formLayout->addRow("Mode:", p.modeComboBox);
+            p.formLayout->addRow("Area size:", p.sizeEdit);
+            p.formLayout->addRow("Minimum:", p.minLabel);
+            p.formLayout->addRow("Maximum:", p.maxLabel);
+            p.formLayout->addRow("Source pixel:", p.sourcePosLabel);
+            p.formLayout->addRow("Source color:", p.sourceColorLabel);
+            p.formLayout->addRow("Source minimum:", p.sourceMinLabel);
+            p.formLayout->addRow("Source maximum:", p.sourceMaxLabel);
 
             auto scrollWidget = ftk::ScrollWidget::create(context);
             scrollWidget->setBorder(false);
             scrollWidget->setWidget(layout);
             _setWidget(scrollWidget);
 
-            p.colorPickerObserver = ftk::ValueObserver<ftk::Color4F>::create(
+            p.colorPickerObserver = ftk::ValueObserver<ColorPickerSample>::create(
                 app->getViewportModel()->observeColorPicker(),
-                [this](const ftk::Color4F& value)
+                [this](const ColorPickerSample& value)
+                {
+                    FTK_P();
+                    bool source = false;
+                    if (auto app = _app.lock())
+                    {
+                        source = ColorPickerMode::Source ==
+                            app->getViewportModel()->getColorPickerMode();
+                    }
+                    p.colorWidget->setColor(source ? value.sourceColor : value.color);
+                    p.minLabel->setText(getText(value.min));
+                    p.maxLabel->setText(getText(value.max));
+                    if (value.source)
+                    {
+                        p.sourcePosLabel->setText(ftk::Format("{0} {1}").
+                            arg(value.sourcePos.x).
+                            arg(value.sourcePos.y));
+                        p.sourceColorLabel->setText(getText(value.sourceColor));
+                        p.sourceMinLabel->setText(getText(value.sourceMin));
+                        p.sourceMaxLabel->setText(getText(value.sourceMax));
+                    }
+                    else
+                    {
+                        p.sourcePosLabel->setText("-");
+                        p.sourceColorLabel->setText(
+                            !value.sourceError.empty() ? value.sourceError : std::string("-"));
+                        p.sourceMinLabel->setText("-");
+                        p.sourceMaxLabel->setText("-");
+                    }
+                });
+
+            p.sizeObserver = ftk::ValueObserver<int>::create(
+                app->getViewportModel()->observeColorPickerSize(),
+                [this](int value)
+                {
+                    _p->sizeEdit->setValue(value);
+                });
+
+            p.modeObserver = ftk::ValueObserver<ColorPickerMode>::create(
+                app->getViewportModel()->observeColorPickerMode(),
+                [this](ColorPickerMode value)
+                {
+                    FTK_P();
+                    p.modeComboBox->setCurrentIndex(static_cast<int>(value));
+                    const bool display =
+                        ColorPickerMode::Display == value ||
+                        ColorPickerMode::Both == value;
+                    const bool source =
+                        ColorPickerMode::Source == value ||
+                        ColorPickerMode::Both == value;
+                    p.formLayout->setRowVisible(p.minLabel, display);
+                    p.formLayout->setRowVisible(p.maxLabel, display);
+                    p.formLayout->setRowVisible(p.sourcePosLabel, source);
+                    p.formLayout->setRowVisible(p.sourceColorLabel, source);
+                    p.formLayout->setRowVisible(p.sourceMinLabel, source);
+                    p.formLayout->setRowVisible(p.sourceMaxLabel, source);
+                });
+
+            p.modeComboBox->setIndexCallback(
+                [this](int value)
+                {
+                    if (auto app = _app.lock())
+                    {
+                        app->getViewportModel()->setColorPickerMode(
+                            static_cast<ColorPickerMode>(value));
+                    }
+                });
+
+            p.sizeEdit->setCallback(
+                [this](int value)
                 {
-                    _p->colorWidget->setColor(value);
+                    if (auto app = _app.lock())
+                    {
+                        app->getViewportModel()->setColorPickerSize(value);
+                    }
                 });
         }
 
@@ -4,15 +4,12 @@
 #include <djvApp/Tools/ExportTool.h>
 
 #include <djvApp/Models/ColorModel.h>
+#include <djvApp/Models/ExportModel.h>
 #include <djvApp/Models/FilesModel.h>
 #include <djvApp/Models/SettingsModel.h>
 #include <djvApp/Models/ViewportModel.h>
 #include <djvApp/App.h>
-
-#include <tlTimelineGL/Render.h>
-
-#include <tlTimeline/IRender.h>
-#include <tlTimeline/Util.h>
+#include <djvApp/Exporter.h>
 
 #include <tlIO/System.h>
 #if defined(TLRENDER_FFMPEG)
@@ -21,19 +18,18 @@
 
 #include <ftk/UI/ComboBox.h>
 #include <ftk/UI/DialogSystem.h>
+#include <ftk/UI/Divider.h>
 #include <ftk/UI/FileEdit.h>
 #include <ftk/UI/FormLayout.h>
 #include <ftk/UI/IntEdit.h>
+#include <ftk/UI/Label.h>
 #include <ftk/UI/LineEdit.h>
-#include <ftk/UI/ProgressDialog.h>
 #include <ftk/UI/PushButton.h>
 #include <ftk/UI/RowLayout.h>
 #include <ftk/UI/ScrollWidget.h>
-#include <ftk/GL/GL.h>
-#include <ftk/GL/OffscreenBuffer.h>
-#include <ftk/GL/Util.h>
+#include <ftk/UI/ToolButton.h>
 #include <ftk/Core/Format.h>
-#include <ftk/Core/Timer.h>
+#include <ftk/Core/String.h>
 
 namespace djv
 {
@@ -48,26 +44,6 @@ namespace djv
             std::vector<std::string> movieExtensions;
             std::vector<std::string> movieCodecs;
 
-            struct ExportData
-            {
-                OTIO_NS::TimeRange range;
-                int64_t frame = 0;
-                tl::file::Path path;
-                ftk::ImageInfo info;
-                std::shared_ptr<tl::io::IWrite> writer;
-                tl::timeline::OCIOOptions ocioOptions;
-                tl::timeline::LUTOptions lutOptions;
-                ftk::ImageOptions imageOptions;
-                tl::timeline::DisplayOptions displayOptions;
-                ftk::ImageType colorBuffer = ftk::ImageType::RGBA_U8;
-                std::shared_ptr<ftk::gl::OffscreenBuffer> buffer;
-                std::shared_ptr<ftk::gl::OffscreenBuffer> buffer2;
-                std::shared_ptr<tl::timeline::IRender> render;
-                GLenum glFormat = 0;
-                GLenum glType = 0;
-            };
-            std::unique_ptr<ExportData> exportData;
-
             std::shared_ptr<ftk::FileEdit> directoryEdit;
             std::shared_ptr<ftk::ComboBox> renderSizeComboBox;
             std::shared_ptr<ftk::IntEdit> renderWidthEdit;
@@ -79,16 +55,23 @@ namespace djv
             std::shared_ptr<ftk::LineEdit> movieBaseNameEdit;
             std::shared_ptr<ftk::ComboBox> movieExtensionComboBox;
             std::shared_ptr<ftk::ComboBox> movieCodecComboBox;
+            std::shared_ptr<ftk::IntEdit> videoRequestsEdit;
+            std::shared_ptr<ftk::IntEdit> writeThreadsEdit;
+            std::shared_ptr<ftk::PushButton> addOutputButton;
             std::shared_ptr<ftk::PushButton> exportButton;
+            std::shared_ptr<ftk::PushButton> clearButton;
+            std::vector<uint64_t> jobIds;
+            std::vector<std::shared_ptr<ftk::Label> > jobLabels;
             std::shared_ptr<ftk::HorizontalLayout> customSizeLayout;
             std::shared_ptr<ftk::FormLayout> formLayout;
+            std::shared_ptr<ftk::VerticalLayout> outputsLayout;
+            std::shared_ptr<ftk::VerticalLayout> jobsLayout;
             std::shared_ptr<ftk::VerticalLayout> layout;
-            std::shared_ptr<ftk::ProgressDialog> progressDialog;
 
             std::shared_ptr<ftk::ValueObserver<std::shared_ptr<tl::timeline::Player> > > playerObserver;
             std::shared_ptr<ftk::ValueObserver<ExportSettings> > settingsObserver;
-
-            std::shared_ptr<ftk::Timer> progressTimer;
+            std::shared_ptr<ftk::ListObserver<ExportSettings> > outputsObserver;
+            std::shared_ptr<ftk::ListObserver<ExportJob> > jobsObserver;
         };
 
         void ExportTool::_init(
@@ -135,7 +118,29 @@ namespace djv
             p.movieExtensionComboBox = ftk::ComboBox::create(context, p.movieExtensions);
             p.movieCodecComboBox = ftk::ComboBox::create(context, p.movieCodecs);
 
+            p.videoRequestsEdit = ftk::IntEdit::create(context);
+            p.videoRequestsEdit->setRange(1, 64);
+            p.videoRequestsEdit->setTooltip(
+                "Number of frames to decode ahead of rendering. When there are "
+                "several outputs the largest value is used.");
+
+            p.writeThreadsEdit = ftk::IntEdit::create(context);
+            p.writeThreadsEdit->setRange(1, 64);
+            p.writeThreadsEdit->setTooltip(
+                "Number of threads used to write image sequences.");
+
+            p.addOutputButton = ftk::PushButton::create(context, "Add Output");
+            p.addOutputButton->setTooltip(
+                "Add the current settings as an output. All of the outputs "
+                "are exported from a single pass over the timeline.");
+
             p.exportButton = ftk::PushButton::create(context, "Export");
+            p.exportButton->setTooltip(
+                "Add an export job to the queue. Jobs run in the background "
+                "so that reviewing can continue.");
+
+            p.clearButton = ftk::PushButton::create(context, "Clear Finished");
+            p.clearButton->setTooltip("Remove the jobs that have finished");
 
             p.layout = ftk::VerticalLayout::create(context);
             p.layout->setMarginRole(ftk::SizeRole::MarginSmall);
@@ -156,7 +161,18 @@ namespace djv
             p.formLayout->addRow("Base name:", p.movieBaseNameEdit);
             p.formLayout->addRow("Extension:", p.movieExtensionComboBox);
             p.formLayout->addRow("Codec:", p.movieCodecComboBox);
-            p.exportButton->setParent(p.layout);
+            p.formLayout->addRow("Video requests:", p.videoRequestsEdit);
+            p.formLayout->addRow("Write threads:", p.writeThreadsEdit);
+            p.outputsLayout = ftk::VerticalLayout::create(context, p.layout);
+            p.outputsLayout->setSpacingRole(ftk::SizeRole::SpacingSmall);
+            auto hLayout = ftk::HorizontalLayout::create(context, p.layout);
+            hLayout->setSpacingRole(ftk::SizeRole::SpacingSmall);
+            p.addOutputButton->setParent(hLayout);
+            p.exportButton->setParent(hLayout);
+            ftk::Divider::create(context, ftk::Orientation::Vertical, p.layout);
+            p.jobsLayout = ftk::VerticalLayout::create(context, p.layout);
+            p.jobsLayout->setSpacingRole(ftk::SizeRole::SpacingSmall);
+            p.clearButton->setParent(p.layout);
 
             auto scrollWidget = ftk::ScrollWidget::create(context);
             scrollWidget->setBorder(false);
@@ -179,6 +195,20 @@ namespace djv
                     _widgetUpdate(value);
                 });
 
+            p.jobsObserver = ftk::ListObserver<ExportJob>::create(
+                app->getExportModel()->observeJobs(),
+                [this](const std::vector<ExportJob>& value)
+                {
+                    _jobsUpdate(value);
+                });
+
+            p.outputsObserver = ftk::ListObserver<ExportSettings>::create(
+                p.model->observeExportOutputs(),
+                [this](const std::vector<ExportSettings>& value)
+                {
+                    _outputsUpdate(value);
+                });
+
             p.directoryEdit->setCallback(
                 [this](const std::filesystem::path& value)
                 {
@@ -287,14 +317,47 @@ namespace djv
                     }
                 });
 
+            p.videoRequestsEdit->setCallback(
+                [this](int value)
+                {
+                    FTK_P();
+                    auto options = p.model->getExport();
+                    options.videoRequests = value;
+                    p.model->setExport(options);
+                });
+
+            p.writeThreadsEdit->setCallback(
+                [this](int value)
+                {
+                    FTK_P();
+                    auto options = p.model->getExport();
+                    options.writeThreads = value;
+                    p.model->setExport(options);
+                });
+
+            p.addOutputButton->setClickedCallback(
+                [this]
+                {
+                    FTK_P();
+                    auto outputs = p.model->getExportOutputs();
+                    outputs.push_back(p.model->getExport());
+                    p.model->setExportOutputs(outputs);
+                });
+
             p.exportButton->setClickedCallback(
                 [this]
                 {
                     _export();
                 });
 
-            p.progressTimer = ftk::Timer::create(context);
-            p.progressTimer->setRepeating(true);
+            p.clearButton->setClickedCallback(
+                [this]
+                {
+                    if (auto app = _p->app.lock())
+                    {
+                        app->getExportModel()->clearFinished();
+                    }
+                });
         }
 
         ExportTool::ExportTool() :
@@ -333,6 +396,9 @@ namespace djv
             i = std::find(p.movieCodecs.begin(), p.movieCodecs.end(), settings.movieCodec);
             p.movieCodecComboBox->setCurrentIndex(i != p.movieCodecs.end() ? (i - p.movieCodecs.begin()) : -1);
 
+            p.videoRequestsEdit->setValue(settings.videoRequests);
+            p.writeThreadsEdit->setValue(settings.writeThreads);
+
             p.formLayout->setRowVisible(p.customSizeLayout, ExportRenderSize::Custom == settings.renderSize);
             p.formLayout->setRowVisible(
                 p.imageBaseNameEdit,
@@ -349,6 +415,52 @@ namespace djv
             p.formLayout->setRowVisible(p.movieBaseNameEdit, ExportFileType::Movie == settings.fileType);
             p.formLayout->setRowVisible(p.movieExtensionComboBox, ExportFileType::Movie == settings.fileType);
             p.formLayout->setRowVisible(p.movieCodecComboBox, ExportFileType::Movie == settings.fileType);
+            p.formLayout->setRowVisible(p.writeThreadsEdit, ExportFileType::Sequence == settings.fileType);
+        }
+
+        void ExportTool::_outputsUpdate(const std::vector<ExportSettings>& value)
+        {
+            FTK_P();
+            auto children = p.outputsLayout->getChildren();
+            for (const auto& child : children)
+            {
+                child->setParent(nullptr);
+            }
+            children.clear();
+            if (auto context = getContext())
+            {
+                for (size_t i = 0; i < value.size(); ++i)
+                {
+                    const ExportSettings& settings = value[i];
+                    const std::string fileName = std::filesystem::u8path(
+                        getExportPath(settings, OTIO_NS::TimeRange()).get()).filename().u8string();
+                    const std::string size = ExportRenderSize::Custom == settings.renderSize ?
+                        std::string(ftk::Format("{0}x{1}").arg(settings.customSize.w).arg(settings.customSize.h)) :
+                        getLabel(settings.renderSize);
+                    auto hLayout = ftk::HorizontalLayout::create(context, p.outputsLayout);
+                    hLayout->setSpacingRole(ftk::SizeRole::SpacingSmall);
+                    auto label = ftk::Label::create(
+                        context,
+                        ftk::Format("{0}: {1}").arg(size).arg(fileName),
+                        hLayout);
+                    label->setHStretch(ftk::Stretch::Expanding);
+                    auto removeButton = ftk::ToolButton::create(context, hLayout);
+                    removeButton->setIcon("Close");
+                    removeButton->setTooltip("Remove the output");
+                    removeButton->setClickedCallback(
+                        [this, i]
+                        {
+                            FTK_P();
+                            auto outputs = p.model->getExportOutputs();
+                            if (i < outputs.size())
+                            {
+                                outputs.erase(outputs.begin() + i);
+                                p.model->setExportOutputs(outputs);
+                            }
+                        });
+                }
+            }
+            p.outputsLayout->setVisible(!value.empty());
         }
 
         void ExportTool::_export()
@@ -360,162 +472,53 @@ namespace djv
             {
                 try
                 {
-                    const tl::io::Info ioInfo = p.player->getIOInfo();
-                    if (ioInfo.video.empty())
-                    {
-                        throw std::runtime_error("No video to render");
-                    }
-                    p.exportData.reset(new Private::ExportData);
-
-                    // Get the time range.
-                    const auto options = p.model->getExport();
-                    switch (options.fileType)
-                    {
-                    case ExportFileType::Image:
-                        p.exportData->range = OTIO_NS::TimeRange(
-                            p.player->getCurrentTime(),
-                            OTIO_NS::RationalTime(1.0, p.player->getTimeRange().duration().rate()));
-                        break;
-                    default:
-                        p.exportData->range = p.player->getInOutRange();
-                        break;
-                    }
-                    p.exportData->frame = p.exportData->range.start_time().value();
-
-                    // Get the render size.
-                    switch (options.renderSize)
+                    // Get the outputs.
+                    ExportOptions options;
+                    options.outputs.push_back(p.model->getExport());
+                    const auto& outputs = p.model->getExportOutputs();
+                    options.outputs.insert(options.outputs.end(), outputs.begin(), outputs.end());
+
+                    // The frames are decoded once for all of the outputs,
+                    // so the job uses the largest video request count.
+                    options.videoRequests = 1;
+                    for (const auto& output : options.outputs)
                     {
-                    case ExportRenderSize::Default:
-                        p.exportData->info.size = ioInfo.video.front().size;
-                        break;
-                    case ExportRenderSize::Custom:
-                        p.exportData->info.size = options.customSize;
-                        break;
-                    default:
-                        p.exportData->info.size = getSize(options.renderSize);
-                        break;
+                        options.videoRequests = std::max(options.videoRequests, output.videoRequests);
                     }
 
-                    // Get the export path.
-                    std::string fileName;
-                    switch (options.fileType)
-                    {
-                    case ExportFileType::Image:
-                    case ExportFileType::Sequence:
-                    {
-                        std::stringstream ss;
-                        ss << options.imageBaseName;
-                        ss << std::setfill('0') << std::setw(options.imageZeroPad) << p.exportData->range.start_time().value();
-                        ss << options.imageExtension;
-                        fileName = ss.str();
-                        break;
-                    }
-                    case ExportFileType::Movie:
-                    {
-                        std::stringstream ss;
-                        ss << options.movieBaseName << options.movieExtension;
-                        fileName = ss.str();
-                        break;
-                    }
-                    default: break;
-                    }
-                    p.exportData->path = tl::file::Path((std::filesystem::u8path(options.directory) /
-                        std::filesystem::u8path(fileName)).u8string());
-
-                    // Get the writer.
-                    auto ioSystem = context->getSystem<tl::io::WriteSystem>();
-                    auto plugin = ioSystem->getPlugin(p.exportData->path);
-                    if (!plugin)
-                    {
-                        throw std::runtime_error(
-                            ftk::Format("Cannot open: \"{0}\"").arg(p.exportData->path.get()));
-                    }
-                    p.exportData->info.type = ioInfo.video.front().type;
-                    p.exportData->info = plugin->getInfo(p.exportData->info);
-                    if (ftk::ImageType::None == p.exportData->info.type)
+                    // Get the time range. If all of the outputs are images
+                    // only the current frame is exported.
+                    bool images = true;
+                    for (const auto& output : options.outputs)
                     {
-                        p.exportData->info.type = ftk::ImageType::RGBA_U8;
+                        images &= ExportFileType::Image == output.fileType;
                     }
-                    p.exportData->glFormat = ftk::gl::getReadPixelsFormat(p.exportData->info.type);
-                    p.exportData->glType = ftk::gl::getReadPixelsType(p.exportData->info.type);
-                    if (GL_NONE == p.exportData->glFormat || GL_NONE == p.exportData->glType)
-                    {
-                        throw std::runtime_error(
-                            ftk::Format("Cannot open: \"{0}\"").arg(p.exportData->path.get()));
-                    }
-                    const double speed = p.player->getSpeed();
-                    tl::io::Info outputInfo;
-                    outputInfo.video.push_back(p.exportData->info);
-                    outputInfo.videoTime = OTIO_NS::TimeRange(
-                        OTIO_NS::RationalTime(0.0, speed),
-                        p.exportData->range.duration().rescaled_to(speed));
-                    tl::io::Options ioOptions;
-                    ioOptions["FFmpeg/Codec"] = options.movieCodec;
-                    p.exportData->writer = plugin->write(p.exportData->path, outputInfo, ioOptions);
-
-                    // Create the renderer.
-                    p.exportData->ocioOptions = app->getColorModel()->getOCIOOptions();
-                    p.exportData->lutOptions = app->getColorModel()->getLUTOptions();
-                    p.exportData->imageOptions = app->getViewportModel()->getImageOptions();
-                    p.exportData->displayOptions = app->getViewportModel()->getDisplayOptions();
-                    p.exportData->colorBuffer = app->getViewportModel()->getColorBuffer();
-                    p.exportData->render = tl::timeline_gl::Render::create(context->getLogSystem());
-                    ftk::gl::OffscreenBufferOptions offscreenBufferOptions;
-                    offscreenBufferOptions.color = p.exportData->colorBuffer;
-                    p.exportData->buffer = ftk::gl::OffscreenBuffer::create(
-                        p.exportData->info.size,
-                        offscreenBufferOptions);
-                    p.exportData->buffer2 = ftk::gl::OffscreenBuffer::create(
-                        p.exportData->info.size,
-                        offscreenBufferOptions);
-
-                    // Create the progress dialog.
-                    p.progressDialog = ftk::ProgressDialog::create(
-                        context,
-                        "Export",
-                        "Rendering:");
-                    p.progressDialog->setRange(0.0, p.exportData->range.duration().value() - 1.0);
-                    p.progressDialog->setMessage(ftk::Format("Frame: {0} / {1}").
-                        arg(p.exportData->frame).
-                        arg(p.exportData->range.end_time_inclusive().value()));
-                    p.progressDialog->setCloseCallback(
-                        [this]
-                        {
-                            FTK_P();
-                            p.progressTimer->stop();
-                            p.exportData.reset();
-                            p.progressDialog.reset();
-                        });
-                    p.progressDialog->open(getWindow());
-                    p.progressTimer->start(
-                        std::chrono::microseconds(500),
-                        [this]
-                        {
-                            FTK_P();
-                            if (_exportFrame())
-                            {
-                                const int64_t start = p.exportData->range.start_time().value();
-                                p.progressDialog->setValue(p.exportData->frame - start);
-                                const int64_t end = p.exportData->range.end_time_inclusive().value();
-                                if (p.exportData->frame <= end)
-                                {
-                                    p.progressDialog->setMessage(ftk::Format("Frame: {0} / {1}").
-                                        arg(p.exportData->frame - start).
-                                        arg(static_cast<int64_t>(p.exportData->range.duration().value())));
-                                }
-                                else
-                                {
-                                    p.progressDialog->close();
-                                }
-                            }
-                        });
+                    options.range = images ?
+                        OTIO_NS::TimeRange(
+                            p.player->getCurrentTime(),
+                            OTIO_NS::RationalTime(1.0, p.player->getTimeRange().duration().rate())) :
+                        p.player->getInOutRange();
+                    options.imageTime = p.player->getCurrentTime();
+                    options.videoLayer = p.player->getVideoLayer();
+                    options.speed = p.player->getSpeed();
+
+                    // Snapshot the color and display options.
+                    options.ocioOptions = app->getColorModel()->getOCIOOptions();
+                    options.lutOptions = app->getColorModel()->getLUTOptions();
+                    options.imageOptions = app->getViewportModel()->getImageOptions();
+                    options.displayOptions = app->getViewportModel()->getDisplayOptions();
+                    options.colorBuffer = app->getViewportModel()->getColorBuffer();
+
+                    // Add the job to the export queue.
+                    auto timeline = p.player->getTimeline();
+                    app->getExportModel()->add(
+                        timeline->getPath(),
+                        timeline->getAudioPath(),
+                        timeline->getOptions(),
+                        options);
                 }
                 catch (const std::exception& e)
                 {
-                    if (p.progressDialog)
-                    {
-                        p.progressDialog->close();
-                    }
                     context->getSystem<ftk::DialogSystem>()->message(
                         "ERROR",
                         ftk::Format("Error: {0}").arg(e.what()),
@@ -524,83 +527,92 @@ namespace djv
             }
         }
 
-        bool ExportTool::_exportFrame()
+        void ExportTool::_jobsUpdate(const std::vector<ExportJob>& value)
         {
             FTK_P();
-            bool out = false;
-            try
-            {
-                // Get the video.
-                const OTIO_NS::RationalTime t(p.exportData->frame, p.exportData->range.duration().rate());
-                auto ioOptions = p.player->getTimeline()->getOptions().ioOptions;
-                ioOptions["Layer"] = ftk::Format("{0}").arg(p.player->getVideoLayer());
-                auto video = p.player->getTimeline()->getVideo(t, ioOptions).future.get();
 
-                // Render the video.
+            // Rebuild the widgets when jobs are added or removed.
+            std::vector<uint64_t> ids;
+            for (const auto& job : value)
+            {
+                ids.push_back(job.id);
+            }
+            if (ids != p.jobIds)
+            {
+                p.jobIds = ids;
+                p.jobLabels.clear();
+                auto children = p.jobsLayout->getChildren();
+                for (const auto& child : children)
                 {
-                    ftk::gl::OffscreenBufferBinding binding(p.exportData->buffer);
-                    p.exportData->render->begin(p.exportData->info.size);
-                    p.exportData->render->setOCIOOptions(p.exportData->ocioOptions);
-                    p.exportData->render->setLUTOptions(p.exportData->lutOptions);
-                    p.exportData->render->drawVideo(
-                        { video },
-                        { ftk::Box2I(0, 0, p.exportData->info.size.w, p.exportData->info.size.h) },
-                        { p.exportData->imageOptions },
-                        { p.exportData->displayOptions },
-                        tl::timeline::CompareOptions(),
-                        p.exportData->colorBuffer);
-                    p.exportData->render->end();
+                    child->setParent(nullptr);
+                }
+                children.clear();
+                if (auto context = getContext())
+                {
+                    for (const auto& job : value)
+                    {
+                        auto hLayout = ftk::HorizontalLayout::create(context, p.jobsLayout);
+                        hLayout->setSpacingRole(ftk::SizeRole::SpacingSmall);
+                        auto label = ftk::Label::create(context, hLayout);
+                        label->setHStretch(ftk::Stretch::Expanding);
+                        p.jobLabels.push_back(label);
+                        auto removeButton = ftk::ToolButton::create(context, hLayout);
+                        removeButton->setIcon("Close");
+                        removeButton->setTooltip("Cancel or remove the job");
+                        const uint64_t id = job.id;
+                        removeButton->setClickedCallback(
+                            [this, id]
+                            {
+                                if (auto app = _p->app.lock())
+                                {
+                                    app->getExportModel()->remove(id);
+                                }
+                            });
+                    }
                 }
-
-                // Flip the image.
-                ftk::gl::OffscreenBufferBinding binding(p.exportData->buffer2);
-                p.exportData->render->begin(p.exportData->info.size);
-                p.exportData->render->setOCIOOptions(tl::timeline::OCIOOptions());
-                p.exportData->render->setLUTOptions(tl::timeline::LUTOptions());
-                p.exportData->render->drawTexture(
-                    p.exportData->buffer->getColorID(),
-                    ftk::Box2I(0, 0, p.exportData->info.size.w, p.exportData->info.size.h));
-                p.exportData->render->end();
-
-                // Write the output image.
-                auto image = ftk::Image::create(p.exportData->info);
-                glPixelStorei(GL_PACK_ALIGNMENT, p.exportData->info.layout.alignment);
-#if defined(FTK_API_GL_4_1)
-                glPixelStorei(GL_PACK_SWAP_BYTES, p.exportData->info.layout.endian != ftk::getEndian());
-#endif // FTK_API_GL_4_1
-                glReadPixels(
-                    0,
-                    0,
-                    p.exportData->info.size.w,
-                    p.exportData->info.size.h,
-                    p.exportData->glFormat,
-                    p.exportData->glType,
-                    image->getData());
-
-                const int64_t start = p.exportData->range.start_time().value();
-                const double speed = p.player->getSpeed();
-                const OTIO_NS::RationalTime t2(p.exportData->frame - start, speed);
-                p.exportData->writer->writeVideo(t2, image);
-
-                ++p.exportData->frame;
-
-                out = true;
             }
-            catch (const std::exception& e)
+
+            // Update the labels.
+            for (size_t i = 0; i < value.size() && i < p.jobLabels.size(); ++i)
             {
-                if (p.progressDialog)
+                const ExportJob& job = value[i];
+                const std::string name = !job.outputs.empty() ?
+                    std::filesystem::u8path(job.outputs.front().get()).filename().u8string() :
+                    std::string();
+                std::string text;
+                switch (job.status)
                 {
-                    p.progressDialog->close();
+                case ExportJobStatus::Running:
+                    text = ftk::Format("{0}: {1} / {2}").
+                        arg(name).
+                        arg(job.frameCount).
+                        arg(job.frameTotal);
+                    break;
+                default:
+                    text = ftk::Format("{0}: {1}").
+                        arg(name).
+                        arg(getLabel(job.status));
+                    break;
                 }
-                if (auto context = getContext())
+                std::vector<std::string> tooltip;
+                tooltip.push_back(ftk::Format("Input: {0}").arg(job.path.get()));
+                for (const auto& output : job.outputs)
                 {
-                    context->getSystem<ftk::DialogSystem>()->message(
-                        "ERROR",
-                        ftk::Format("Error: {0}").arg(e.what()),
-                        getWindow());
+                    tooltip.push_back(ftk::Format("Output: {0}").arg(output.get()));
+                }
+                if (!job.error.empty())
+                {
+                    tooltip.push_back(ftk::Format("Error: {0}").arg(job.error));
                 }
+                else if (job.status != ExportJobStatus::Queued)
+                {
+                    tooltip.push_back(getExportTimingsSummary(job.timings));
+                }
+                p.jobLabels[i]->setText(text);
+                p.jobLabels[i]->setTooltip(ftk::join(tooltip, "\n"));
             }
-            return out;
+            p.jobsLayout->setVisible(!value.empty());
+            p.clearButton->setEnabled(!value.empty());
         }
     }
 }
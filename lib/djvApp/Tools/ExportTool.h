@@ -9,6 +9,7 @@ namespace djv
 {
     namespace app
     {
+        struct ExportJob;
         struct ExportSettings;
 
         class App;
@@ -36,8 +37,9 @@ namespace djv
 
         private:
             void _widgetUpdate(const ExportSettings&);
+            void _outputsUpdate(const std::vector<ExportSettings>&);
+            void _jobsUpdate(const std::vector<ExportJob>&);
             void _export();
-            bool _exportFrame();
 
             FTK_PRIVATE();
         };
@@ -7,6 +7,7 @@
 
 #include <ftk/UI/DrawUtil.h>
 #include <ftk/Core/Context.h>
+#include <ftk/Core/Format.h>
 
 #include <optional>
 
@@ -17,6 +18,7 @@ namespace djv
         struct FileButton::Private
         {
             std::shared_ptr<FilesModelItem> item;
+            std::string name;
 
             struct SizeData
             {
@@ -33,6 +35,7 @@ namespace djv
             struct ThumbnailData
             {
                 bool init = true;
+                size_t generation = 0;
                 float scale = 1.F;
                 int height = 40;
                 tl::timelineui::ThumbnailRequest request;
@@ -45,6 +48,8 @@ namespace djv
                 std::vector<std::shared_ptr<ftk::Glyph> > glyphs;
             };
             std::optional<DrawData> draw;
+
+            std::shared_ptr<ftk::ValueObserver<FilesModelLoadState> > loadObserver;
         };
 
         void FileButton::_init(
@@ -54,13 +59,19 @@ namespace djv
         {
             IButton::_init(context, "djv::app::FileButton", parent);
             FTK_P();
-            const std::string s = ftk::elide(item->path.get(-1, tl::file::PathType::FileName));
-            setText(s);
             setCheckable(true);
             setHStretch(ftk::Stretch::Expanding);
             setAcceptsKeyFocus(true);
             _buttonRole = ftk::ColorRole::None;
             p.item = item;
+            p.name = ftk::elide(item->path.get(-1, tl::file::PathType::FileName));
+
+            p.loadObserver = ftk::ValueObserver<FilesModelLoadState>::create(
+                item->load,
+                [this](const FilesModelLoadState& value)
+                {
+                    _loadUpdate(value);
+                });
         }
 
         FileButton::FileButton() :
@@ -123,13 +134,16 @@ namespace djv
             if (p.thumbnail.init)
             {
                 p.thumbnail.init = false;
+                p.thumbnail.generation = p.item->generation;
                 if (auto context = getContext())
                 {
                     auto thumbnailSystem = context->getSystem<tl::timelineui::ThumbnailSystem>();
                     p.thumbnail.request = thumbnailSystem->getThumbnail(
                         reinterpret_cast<intptr_t>(p.item.get()),
                         p.item->path,
-                        p.thumbnail.height);
+                        p.thumbnail.height,
+                        tl::time::invalidTime,
+                        getGenerationOptions(*p.item));
                 }
             }
 
@@ -261,5 +275,46 @@ namespace djv
         {
             event.accept = true;
         }
+
+        void FileButton::_loadUpdate(const FilesModelLoadState& value)
+        {
+            FTK_P();
+            std::string text = p.name;
+            std::string tooltip = p.item->path.get();
+            switch (value.status)
+            {
+            case FilesModelLoad::Queued:
+                text = ftk::Format("{0} (Queued)").arg(p.name);
+                break;
+            case FilesModelLoad::Loading:
+                text = ftk::Format("{0} (Loading)").arg(p.name);
+                if (value.stage != FilesModelLoadStage::None)
+                {
+                    tooltip = ftk::Format("{0}\n\n{1}").
+                        arg(tooltip).
+                        arg(getLabel(value.stage));
+                }
+                break;
+            case FilesModelLoad::Error:
+                text = ftk::Format("{0} (Error)").arg(p.name);
+                tooltip = ftk::Format("{0}\n\nError: {1}").
+                    arg(tooltip).
+                    arg(value.error);
+                break;
+            default: break;
+            }
+            setText(text);
+            setTooltip(tooltip);
+            if (FilesModelLoad::Ready == value.status &&
+                p.item->generation != p.thumbnail.generation)
+            {
+                // The file has changed on disk.
+                p.thumbnail.init = true;
+            }
+            p.size.displayScale.reset();
+            p.draw.reset();
+            setSizeUpdate();
+            setDrawUpdate();
+        }
     }
 }
@@ -45,6 +45,7 @@ namespace djv
             std::shared_ptr<ftk::ValueObserver<std::shared_ptr<FilesModelItem> > > aObserver;
             std::shared_ptr<ftk::ListObserver<std::shared_ptr<FilesModelItem> > > bObserver;
             std::shared_ptr<ftk::ListObserver<int> > layersObserver;
+            std::vector<std::shared_ptr<ftk::ValueObserver<FilesModelLoadState> > > loadObservers;
             std::shared_ptr<ftk::ValueObserver<tl::timeline::CompareOptions> > compareObserver;
             std::shared_ptr<ftk::ValueObserver<tl::timeline::CompareTime> > compareTimeObserver;
         };
@@ -270,7 +271,10 @@ namespace djv
             FTK_P();
             p.aButtonGroup->clearButtons();
             p.bButtonGroup->clearButtons();
+            p.aButtons.clear();
+            p.bButtons.clear();
             p.layerComboBoxes.clear();
+            p.loadObservers.clear();
             auto children = p.widgetLayout->getChildren();
             for (const auto& widget : children)
             {
@@ -289,7 +293,6 @@ namespace djv
                     {
                         auto aButton = FileButton::create(context, item);
                         aButton->setChecked(item == a);
-                        aButton->setTooltip(item->path.get());
                         p.aButtons[item] = aButton;
                         p.aButtonGroup->addButton(aButton);
                         aButton->setParent(p.widgetLayout);
@@ -324,6 +327,21 @@ namespace djv
                                 }
                             });
 
+                        // The layers are not known until the file has been
+                        // loaded at least once.
+                        p.loadObservers.push_back(ftk::ValueObserver<FilesModelLoadState>::create(
+                            item->load,
+                            [this, row, item](const FilesModelLoadState& value)
+                            {
+                                FTK_P();
+                                if (row < p.layerComboBoxes.size())
+                                {
+                                    p.layerComboBoxes[row]->setItems(item->videoLayers);
+                                    p.layerComboBoxes[row]->setCurrentIndex(item->videoLayer);
+                                    p.layerComboBoxes[row]->setEnabled(!item->videoLayers.empty());
+                                }
+                            }));
+
                         ++row;
                     }
                     if (value.empty())
@@ -42,6 +42,8 @@ namespace djv
             void keyReleaseEvent(ftk::KeyEvent&) override;
 
         private:
+            void _loadUpdate(const FilesModelLoadState&);
+
             FTK_PRIVATE();
         };
     }
@@ -0,0 +1,369 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djvApp/Tools/ScopesToolPrivate.h>
+
+#include <djvApp/App.h>
+#include <djvApp/ImageUtil.h>
+
+#include <ftk/UI/ComboBox.h>
+#include <ftk/UI/Label.h>
+#include <ftk/UI/RowLayout.h>
+#include <ftk/UI/Settings.h>
+
+#include <tlTimeline/Player.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace djv
+{
+    namespace app
+    {
+        namespace
+        {
+            const int scopeSizeMax = 1024;
+        }
+
+        struct ScopeWidget::Private
+        {
+            ScopeType type = ScopeType::Histogram;
+            std::shared_ptr<ftk::Image> image;
+        };
+
+        void ScopeWidget::_init(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::shared_ptr<IWidget>& parent)
+        {
+            IWidget::_init(context, "djv::app::ScopeWidget", parent);
+            setStretch(ftk::Stretch::Expanding);
+        }
+
+        ScopeWidget::ScopeWidget() :
+            _p(new Private)
+        {}
+
+        ScopeWidget::~ScopeWidget()
+        {}
+
+        std::shared_ptr<ScopeWidget> ScopeWidget::create(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::shared_ptr<IWidget>& parent)
+        {
+            auto out = std::shared_ptr<ScopeWidget>(new ScopeWidget);
+            out->_init(context, parent);
+            return out;
+        }
+
+        void ScopeWidget::setType(ScopeType value)
+        {
+            FTK_P();
+            if (value == p.type)
+                return;
+            p.type = value;
+            setDrawUpdate();
+        }
+
+        void ScopeWidget::setImage(const std::shared_ptr<ftk::Image>& value)
+        {
+            FTK_P();
+            if (value == p.image)
+                return;
+            p.image = value;
+            setDrawUpdate();
+        }
+
+        void ScopeWidget::sizeHintEvent(const ftk::SizeHintEvent& event)
+        {
+            IWidget::sizeHintEvent(event);
+            const int size = 256 * event.displayScale;
+            _setSizeHint(ftk::Size2I(size, size));
+        }
+
+        void ScopeWidget::drawEvent(const ftk::Box2I& drawRect, const ftk::DrawEvent& event)
+        {
+            IWidget::drawEvent(drawRect, event);
+            FTK_P();
+            const ftk::Box2I& g = getGeometry();
+            event.render->drawRect(g, ftk::Color4F(0.F, 0.F, 0.F));
+            if (p.image)
+            {
+                event.render->drawImage(p.image, g, ftk::Color4F(1.F, 1.F, 1.F));
+            }
+
+            // Draw the graticule.
+            const ftk::Color4F color(1.F, 1.F, 1.F, .2F);
+            switch (p.type)
+            {
+            case ScopeType::Histogram:
+                for (int i = 1; i < 4; ++i)
+                {
+                    const int x = g.min.x + g.w() * i / 4;
+                    event.render->drawRect(ftk::Box2I(x, g.min.y, 1, g.h()), color);
+                }
+                break;
+            case ScopeType::Waveform:
+            case ScopeType::Parade:
+                for (int i = 0; i <= 4; ++i)
+                {
+                    const int y = g.min.y + (g.h() - 1) * i / 4;
+                    event.render->drawRect(ftk::Box2I(g.min.x, y, g.w(), 1), color);
+                }
+                if (ScopeType::Parade == p.type)
+                {
+                    for (int i = 1; i < 3; ++i)
+                    {
+                        const int x = g.min.x + g.w() * i / 3;
+                        event.render->drawRect(ftk::Box2I(x, g.min.y, 1, g.h()), color);
+                    }
+                }
+                break;
+            case ScopeType::Vectorscope:
+            {
+                const ftk::V2I c = ftk::center(g);
+                event.render->drawRect(ftk::Box2I(c.x, g.min.y, 1, g.h()), color);
+                event.render->drawRect(ftk::Box2I(g.min.x, c.y, g.w(), 1), color);
+                break;
+            }
+            default: break;
+            }
+        }
+
+        struct ScopesTool::Private
+        {
+            std::shared_ptr<ftk::Settings> settings;
+            ScopeType type = ScopeType::Histogram;
+            std::shared_ptr<ftk::Image> image;
+            ftk::Size2I size;
+            bool changed = false;
+
+            std::shared_ptr<ftk::ComboBox> typeComboBox;
+            std::shared_ptr<ftk::Label> messageLabel;
+            std::shared_ptr<ScopeWidget> scopeWidget;
+
+            std::shared_ptr<ftk::ValueObserver<std::shared_ptr<tl::timeline::Player> > > playerObserver;
+            std::shared_ptr<ftk::ListObserver<tl::timeline::VideoData> > videoObserver;
+
+            struct Request
+            {
+                std::shared_ptr<ftk::Image> image;
+                ScopeType type = ScopeType::Histogram;
+                ftk::Size2I size;
+            };
+
+            struct Thread
+            {
+                std::mutex mutex;
+                std::condition_variable cv;
+                bool hasRequest = false;
+                Request request;
+                bool hasResult = false;
+                std::shared_ptr<ftk::Image> result;
+                std::atomic<bool> running;
+                std::thread thread;
+            };
+            Thread thread;
+        };
+
+        void ScopesTool::_init(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::shared_ptr<App>& app,
+            const std::shared_ptr<IWidget>& parent)
+        {
+            IToolWidget::_init(
+                context,
+                app,
+                Tool::Scopes,
+                "djv::app::ScopesTool",
+                parent);
+            FTK_P();
+
+            p.settings = app->getSettings();
+            std::string s = to_string(p.type);
+            p.settings->get("/Scopes/Type", s);
+            from_string(s, p.type);
+
+            p.typeComboBox = ftk::ComboBox::create(context, getScopeTypeLabels());
+            p.typeComboBox->setCurrentIndex(static_cast<int>(p.type));
+            p.typeComboBox->setHStretch(ftk::Stretch::Expanding);
+
+            p.messageLabel = ftk::Label::create(context);
+            p.messageLabel->setVisible(false);
+
+            p.scopeWidget = ScopeWidget::create(context);
+            p.scopeWidget->setType(p.type);
+
+            auto layout = ftk::VerticalLayout::create(context);
+            layout->setMarginRole(ftk::SizeRole::MarginSmall);
+            layout->setSpacingRole(ftk::SizeRole::SpacingSmall);
+            p.typeComboBox->setParent(layout);
+            p.messageLabel->setParent(layout);
+            p.scopeWidget->setParent(layout);
+            _setWidget(layout);
+
+            p.thread.running = true;
+            p.thread.thread = std::thread(
+                [this]
+                {
+                    FTK_P();
+                    while (p.thread.running)
+                    {
+                        Private::Request request;
+                        {
+                            std::unique_lock<std::mutex> lock(p.thread.mutex);
+                            if (p.thread.cv.wait_for(
+                                lock,
+                                std::chrono::milliseconds(100),
+                                [this]
+                                {
+                                    return _p->thread.hasRequest;
+                                }))
+                            {
+                                request = std::move(p.thread.request);
+                                p.thread.hasRequest = false;
+                            }
+                        }
+                        if (request.image)
+                        {
+                            auto result = getScope(request.image, request.type, request.size);
+                            std::unique_lock<std::mutex> lock(p.thread.mutex);
+                            p.thread.result = result;
+                            p.thread.hasResult = true;
+                        }
+                    }
+                });
+
+            p.playerObserver = ftk::ValueObserver<std::shared_ptr<tl::timeline::Player> >::create(
+                app->observePlayer(),
+                [this](const std::shared_ptr<tl::timeline::Player>& value)
+                {
+                    FTK_P();
+                    if (value)
+                    {
+                        p.videoObserver = ftk::ListObserver<tl::timeline::VideoData>::create(
+                            value->observeCurrentVideo(),
+                            [this](const std::vector<tl::timeline::VideoData>& value)
+                            {
+                                FTK_P();
+                                p.image.reset();
+                                if (!value.empty() && !value.front().layers.empty())
+                                {
+                                    p.image = value.front().layers.front().image;
+                                }
+                                p.changed = true;
+                            });
+                    }
+                    else
+                    {
+                        p.videoObserver.reset();
+                        p.image.reset();
+                        p.changed = true;
+                    }
+                });
+
+            p.typeComboBox->setIndexCallback(
+                [this](int value)
+                {
+                    FTK_P();
+                    p.type = static_cast<ScopeType>(value);
+                    p.scopeWidget->setType(p.type);
+                    p.scopeWidget->setImage(nullptr);
+                    p.changed = true;
+                });
+        }
+
+        ScopesTool::ScopesTool() :
+            _p(new Private)
+        {}
+
+        ScopesTool::~ScopesTool()
+        {
+            FTK_P();
+            p.thread.running = false;
+            if (p.thread.thread.joinable())
+            {
+                p.thread.thread.join();
+            }
+            p.settings->set("/Scopes/Type", to_string(p.type));
+        }
+
+        std::shared_ptr<ScopesTool> ScopesTool::create(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::shared_ptr<App>& app,
+            const std::shared_ptr<IWidget>& parent)
+        {
+            auto out = std::shared_ptr<ScopesTool>(new ScopesTool);
+            out->_init(context, app, parent);
+            return out;
+        }
+
+        void ScopesTool::tickEvent(
+            bool parentsVisible,
+            bool parentsEnabled,
+            const ftk::TickEvent& event)
+        {
+            IToolWidget::tickEvent(parentsVisible, parentsEnabled, event);
+            FTK_P();
+
+            // The scope is computed at the size of the widget.
+            const ftk::Size2I& size = p.scopeWidget->getGeometry().size();
+            const ftk::Size2I size2(
+                std::min(size.w, scopeSizeMax),
+                std::min(size.h, scopeSizeMax));
+            if (size2 != p.size)
+            {
+                p.size = size2;
+                p.changed = true;
+            }
+            if (p.changed)
+            {
+                p.changed = false;
+                _request();
+            }
+
+            std::shared_ptr<ftk::Image> result;
+            bool hasResult = false;
+            {
+                std::unique_lock<std::mutex> lock(p.thread.mutex);
+                std::swap(hasResult, p.thread.hasResult);
+                result = std::move(p.thread.result);
+            }
+            if (hasResult)
+            {
+                p.scopeWidget->setImage(result);
+            }
+        }
+
+        void ScopesTool::_request()
+        {
+            FTK_P();
+            const bool readable = p.image && isReadable(p.image->getType());
+            p.messageLabel->setText(
+                p.image && !readable ? getUnreadableText(p.image->getType()) : std::string());
+            p.messageLabel->setVisible(p.image && !readable);
+            if (readable && p.size.isValid())
+            {
+                {
+                    std::unique_lock<std::mutex> lock(p.thread.mutex);
+                    p.thread.request.image = p.image;
+                    p.thread.request.type = p.type;
+                    p.thread.request.size = p.size;
+                    p.thread.hasRequest = true;
+                }
+                p.thread.cv.notify_one();
+            }
+            else
+            {
+                {
+                    std::unique_lock<std::mutex> lock(p.thread.mutex);
+                    p.thread.hasRequest = false;
+                    p.thread.hasResult = false;
+                    p.thread.result.reset();
+                }
+                p.scopeWidget->setImage(nullptr);
+            }
+        }
+    }
+}
@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <djvApp/Tools/IToolWidget.h>
+
+namespace djv
+{
+    namespace app
+    {
+        class App;
+
+        //! Scopes tool.
+        //!
+        //! The scopes are computed from the current video on a separate
+        //! thread. While the scope is being computed new frames replace the
+        //! pending frame, so the scope may skip frames during playback but
+        //! never slows it down.
+        class ScopesTool : public IToolWidget
+        {
+            FTK_NON_COPYABLE(ScopesTool);
+
+        protected:
+            void _init(
+                const std::shared_ptr<ftk::Context>&,
+                const std::shared_ptr<App>&,
+                const std::shared_ptr<IWidget>& parent);
+
+            ScopesTool();
+
+        public:
+            virtual ~ScopesTool();
+
+            static std::shared_ptr<ScopesTool> create(
+                const std::shared_ptr<ftk::Context>&,
+                const std::shared_ptr<App>&,
+                const std::shared_ptr<IWidget>& parent = nullptr);
+
+            void tickEvent(
+                bool parentsVisible,
+                bool parentsEnabled,
+                const ftk::TickEvent&) override;
+
+        private:
+            void _request();
+
+            FTK_PRIVATE();
+        };
+    }
+}
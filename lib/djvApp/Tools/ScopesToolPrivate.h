@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <djvApp/Tools/ScopesTool.h>
+
+#include <djvApp/Scopes.h>
+
+namespace djv
+{
+    namespace app
+    {
+        class ScopeWidget : public ftk::IWidget
+        {
+            FTK_NON_COPYABLE(ScopeWidget);
+
+        protected:
+            void _init(
+                const std::shared_ptr<ftk::Context>&,
+                const std::shared_ptr<IWidget>& parent);
+
+            ScopeWidget();
+
+        public:
+            virtual ~ScopeWidget();
+
+            static std::shared_ptr<ScopeWidget> create(
+                const std::shared_ptr<ftk::Context>&,
+                const std::shared_ptr<IWidget>& parent = nullptr);
+
+            //! Set the scope type. This is used to draw the graticule.
+            void setType(ScopeType);
+
+            //! Set the scope image.
+            void setImage(const std::shared_ptr<ftk::Image>&);
+
+            void sizeHintEvent(const ftk::SizeHintEvent&) override;
+            void drawEvent(const ftk::Box2I&, const ftk::DrawEvent&) override;
+
+        private:
+            FTK_PRIVATE();
+        };
+    }
+}
@@ -42,6 +42,12 @@ namespace djv
             std::shared_ptr<ftk::IntEdit> audioBufferFramesEdit;
             std::shared_ptr<ftk::IntEdit> videoRequestsEdit;
             std::shared_ptr<ftk::IntEdit> audioRequestsEdit;
+            std::shared_ptr<ftk::IntEdit> timelineUnloadEdit;
+            std::shared_ptr<ftk::CheckBox> standbyCheckBox;
+            std::shared_ptr<ftk::FloatEdit> standbyCacheEdit;
+            std::shared_ptr<ftk::IntEdit> playerPoolEdit;
+            std::shared_ptr<ftk::CheckBox> probeCacheCheckBox;
+            std::shared_ptr<ftk::IntEdit> probeCacheEdit;
             std::shared_ptr<ftk::VerticalLayout> layout;
 
             std::shared_ptr<ftk::ValueObserver<AdvancedSettings> > settingsObserver;
@@ -72,6 +78,42 @@ namespace djv
             p.audioRequestsEdit = ftk::IntEdit::create(context);
             p.audioRequestsEdit->setRange(1, 64);
 
+            p.timelineUnloadEdit = ftk::IntEdit::create(context);
+            p.timelineUnloadEdit->setRange(0, 3600);
+            p.timelineUnloadEdit->setStep(10);
+            p.timelineUnloadEdit->setLargeStep(60);
+            p.timelineUnloadEdit->setTooltip(
+                "Unload the timelines of files that are not active after the given "
+                "number of seconds. A value of zero disables unloading.");
+
+            p.standbyCheckBox = ftk::CheckBox::create(context);
+            p.standbyCheckBox->setHStretch(ftk::Stretch::Expanding);
+            p.standbyCheckBox->setTooltip(
+                "Create a player for the next file ahead of time, so that "
+                "switching to it starts playback immediately.");
+
+            p.standbyCacheEdit = ftk::FloatEdit::create(context);
+            p.standbyCacheEdit->setRange(0.F, 1024.F);
+            p.standbyCacheEdit->setStep(.1F);
+            p.standbyCacheEdit->setLargeStep(1.F);
+            p.standbyCacheEdit->setTooltip("Video cache for the standby player.");
+
+            p.playerPoolEdit = ftk::IntEdit::create(context);
+            p.playerPoolEdit->setRange(0, 16);
+            p.playerPoolEdit->setTooltip(
+                "Keep the players of recently viewed files, so that switching "
+                "back to them keeps their cache.");
+
+            p.probeCacheCheckBox = ftk::CheckBox::create(context);
+            p.probeCacheCheckBox->setHStretch(ftk::Stretch::Expanding);
+            p.probeCacheCheckBox->setTooltip(
+                "Store information about opened files on disk, so that "
+                "reopening them is faster.");
+
+            p.probeCacheEdit = ftk::IntEdit::create(context);
+            p.probeCacheEdit->setRange(1, 1024);
+            p.probeCacheEdit->setTooltip("Maximum size of the probe cache.");
+
             p.layout = ftk::VerticalLayout::create(context, shared_from_this());
             p.layout->setMarginRole(ftk::SizeRole::Margin);
             p.layout->setSpacingRole(ftk::SizeRole::SpacingSmall);
@@ -82,6 +124,12 @@ namespace djv
             formLayout->addRow("Audio buffer frames:", p.audioBufferFramesEdit);
             formLayout->addRow("Video requests:", p.videoRequestsEdit);
             formLayout->addRow("Audio requests:", p.audioRequestsEdit);
+            formLayout->addRow("Unload timelines (seconds):", p.timelineUnloadEdit);
+            formLayout->addRow("Standby player:", p.standbyCheckBox);
+            formLayout->addRow("Standby cache (GB):", p.standbyCacheEdit);
+            formLayout->addRow("Recent players:", p.playerPoolEdit);
+            formLayout->addRow("Probe cache:", p.probeCacheCheckBox);
+            formLayout->addRow("Probe cache (MB):", p.probeCacheEdit);
 
             p.settingsObserver = ftk::ValueObserver<AdvancedSettings>::create(
                 p.model->observeAdvanced(),
@@ -92,6 +140,12 @@ namespace djv
                     p.audioBufferFramesEdit->setValue(value.audioBufferFrameCount);
                     p.videoRequestsEdit->setValue(value.videoRequestMax);
                     p.audioRequestsEdit->setValue(value.audioRequestMax);
+                    p.timelineUnloadEdit->setValue(value.timelineUnloadTimeout);
+                    p.standbyCheckBox->setChecked(value.standbyPlayer);
+                    p.standbyCacheEdit->setValue(value.standbyCacheGB);
+                    p.playerPoolEdit->setValue(value.playerPoolSize);
+                    p.probeCacheCheckBox->setChecked(value.probeCache);
+                    p.probeCacheEdit->setValue(value.probeCacheMB);
                 });
 
             p.compatCheckBox->setCheckedCallback(
@@ -129,6 +183,60 @@ namespace djv
                     settings.audioRequestMax = value;
                     p.model->setAdvanced(settings);
                 });
+
+            p.timelineUnloadEdit->setCallback(
+                [this](int value)
+                {
+                    FTK_P();
+                    auto settings = p.model->getAdvanced();
+                    settings.timelineUnloadTimeout = value;
+                    p.model->setAdvanced(settings);
+                });
+
+            p.standbyCheckBox->setCheckedCallback(
+                [this](bool value)
+                {
+                    FTK_P();
+                    auto settings = p.model->getAdvanced();
+                    settings.standbyPlayer = value;
+                    p.model->setAdvanced(settings);
+                });
+
+            p.standbyCacheEdit->setCallback(
+                [this](float value)
+                {
+                    FTK_P();
+                    auto settings = p.model->getAdvanced();
+                    settings.standbyCacheGB = value;
+                    p.model->setAdvanced(settings);
+                });
+
+            p.playerPoolEdit->setCallback(
+                [this](int value)
+                {
+                    FTK_P();
+                    auto settings = p.model->getAdvanced();
+                    settings.playerPoolSize = value;
+                    p.model->setAdvanced(settings);
+                });
+
+            p.probeCacheCheckBox->setCheckedCallback(
+                [this](bool value)
+                {
+                    FTK_P();
+                    auto settings = p.model->getAdvanced();
+                    settings.probeCache = value;
+                    p.model->setAdvanced(settings);
+                });
+
+            p.probeCacheEdit->setCallback(
+                [this](int value)
+                {
+                    FTK_P();
+                    auto settings = p.model->getAdvanced();
+                    settings.probeCacheMB = value;
+                    p.model->setAdvanced(settings);
+                });
         }
 
         AdvancedSettingsWidget::AdvancedSettingsWidget() :
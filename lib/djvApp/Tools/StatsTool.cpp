@@ -0,0 +1,345 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djvApp/Tools/StatsTool.h>
+
+#include <djvApp/Models/StatsModel.h>
+#include <djvApp/App.h>
+#include <djvApp/ImageUtil.h>
+
+#include <tlTimeline/Player.h>
+
+#include <ftk/UI/Bellows.h>
+#include <ftk/UI/DialogSystem.h>
+#include <ftk/UI/FileEdit.h>
+#include <ftk/UI/FormLayout.h>
+#include <ftk/UI/Label.h>
+#include <ftk/UI/PushButton.h>
+#include <ftk/UI/RowLayout.h>
+#include <ftk/UI/ScrollWidget.h>
+#include <ftk/UI/Settings.h>
+#include <ftk/Core/Format.h>
+#include <ftk/Core/String.h>
+
+#include <array>
+#include <future>
+
+namespace djv
+{
+    namespace app
+    {
+        namespace
+        {
+            std::string getText(const ImageStats& value)
+            {
+                std::vector<std::string> lines;
+                lines.push_back("     Minimum    Maximum       Mean");
+                const std::array<std::string, 4> channels = { "R", "G", "B", "A" };
+                const float* min = &value.min.r;
+                const float* max = &value.max.r;
+                const float* mean = &value.mean.r;
+                for (size_t c = 0; c < 4; ++c)
+                {
+                    lines.push_back(ftk::Format("{0} {1} {2} {3}").
+                        arg(channels[c]).
+                        arg(min[c], 4, 10).
+                        arg(max[c], 4, 10).
+                        arg(mean[c], 4, 10));
+                }
+                lines.push_back(ftk::Format("NaN: {0}").arg(value.nanCount));
+                lines.push_back(ftk::Format("Inf: {0}").arg(value.infCount));
+                lines.push_back(ftk::Format("Negative: {0}").arg(value.negativeCount));
+                return ftk::join(lines, "\n");
+            }
+        }
+
+        struct StatsTool::Private
+        {
+            std::shared_ptr<ftk::Settings> settings;
+            std::shared_ptr<tl::timeline::Player> player;
+            std::shared_ptr<ftk::Image> image;
+            bool changed = false;
+            std::future<ImageStats> future;
+            std::filesystem::path reportPath;
+
+            std::shared_ptr<ftk::Label> currentLabel;
+            std::shared_ptr<ftk::Label> sweepLabel;
+            std::shared_ptr<ftk::PushButton> startButton;
+            std::shared_ptr<ftk::PushButton> cancelButton;
+            std::shared_ptr<ftk::FileEdit> reportEdit;
+            std::shared_ptr<ftk::PushButton> saveButton;
+            std::map<std::string, std::shared_ptr<ftk::Bellows> > bellows;
+
+            std::shared_ptr<ftk::ValueObserver<std::shared_ptr<tl::timeline::Player> > > playerObserver;
+            std::shared_ptr<ftk::ListObserver<tl::timeline::VideoData> > videoObserver;
+            std::shared_ptr<ftk::ValueObserver<StatsSweep> > sweepObserver;
+        };
+
+        void StatsTool::_init(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::shared_ptr<App>& app,
+            const std::shared_ptr<IWidget>& parent)
+        {
+            IToolWidget::_init(
+                context,
+                app,
+                Tool::Statistics,
+                "djv::app::StatsTool",
+                parent);
+            FTK_P();
+
+            p.settings = app->getSettings();
+            std::string s;
+            p.settings->get("/Statistics/Report", s);
+            p.reportPath = std::filesystem::u8path(s);
+
+            p.currentLabel = ftk::Label::create(context);
+            p.currentLabel->setFontRole(ftk::FontRole::Mono);
+            p.currentLabel->setMarginRole(ftk::SizeRole::MarginSmall);
+
+            p.sweepLabel = ftk::Label::create(context);
+
+            p.startButton = ftk::PushButton::create(context, "Start");
+            p.startButton->setTooltip("Compute the statistics of every frame in the in/out range.");
+
+            p.cancelButton = ftk::PushButton::create(context, "Cancel");
+
+            p.reportEdit = ftk::FileEdit::create(context, ftk::FileBrowserMode::File);
+            p.reportEdit->setPath(p.reportPath);
+            p.reportEdit->setTooltip(
+                "Report file name. Reports with a .json extension are written "
+                "as JSON, otherwise they are written as CSV.");
+
+            p.saveButton = ftk::PushButton::create(context, "Save Report");
+
+            auto layout = ftk::VerticalLayout::create(context);
+            layout->setSpacingRole(ftk::SizeRole::None);
+            p.bellows["Current"] = ftk::Bellows::create(context, "Current Frame", layout);
+            p.bellows["Current"]->setWidget(p.currentLabel);
+            auto vLayout = ftk::VerticalLayout::create(context);
+            vLayout->setMarginRole(ftk::SizeRole::MarginSmall);
+            vLayout->setSpacingRole(ftk::SizeRole::SpacingSmall);
+            p.sweepLabel->setParent(vLayout);
+            auto hLayout = ftk::HorizontalLayout::create(context, vLayout);
+            hLayout->setSpacingRole(ftk::SizeRole::SpacingSmall);
+            p.startButton->setParent(hLayout);
+            p.cancelButton->setParent(hLayout);
+            auto formLayout = ftk::FormLayout::create(context, vLayout);
+            formLayout->setSpacingRole(ftk::SizeRole::SpacingSmall);
+            formLayout->addRow("Report:", p.reportEdit);
+            p.saveButton->setParent(vLayout);
+            p.bellows["Sweep"] = ftk::Bellows::create(context, "In/Out Range", layout);
+            p.bellows["Sweep"]->setWidget(vLayout);
+            auto scrollWidget = ftk::ScrollWidget::create(context);
+            scrollWidget->setBorder(false);
+            scrollWidget->setWidget(layout);
+            _setWidget(scrollWidget);
+
+            _loadSettings(p.bellows);
+
+            p.playerObserver = ftk::ValueObserver<std::shared_ptr<tl::timeline::Player> >::create(
+                app->observePlayer(),
+                [this](const std::shared_ptr<tl::timeline::Player>& value)
+                {
+                    FTK_P();
+                    p.player = value;
+                    p.startButton->setEnabled(value.get());
+                    if (value)
+                    {
+                        p.videoObserver = ftk::ListObserver<tl::timeline::VideoData>::create(
+                            value->observeCurrentVideo(),
+                            [this](const std::vector<tl::timeline::VideoData>& value)
+                            {
+                                FTK_P();
+                                p.image.reset();
+                                if (!value.empty() && !value.front().layers.empty())
+                                {
+                                    p.image = value.front().layers.front().image;
+                                }
+                                p.changed = true;
+                            });
+                    }
+                    else
+                    {
+                        p.videoObserver.reset();
+                        p.image.reset();
+                        p.changed = true;
+                    }
+                });
+
+            p.sweepObserver = ftk::ValueObserver<StatsSweep>::create(
+                app->getStatsModel()->observeSweep(),
+                [this](const StatsSweep& value)
+                {
+                    _sweepUpdate(value);
+                });
+
+            p.startButton->setClickedCallback(
+                [this]
+                {
+                    FTK_P();
+                    auto app = _app.lock();
+                    if (app && p.player)
+                    {
+                        auto timeline = p.player->getTimeline();
+                        app->getStatsModel()->start(
+                            timeline->getPath(),
+                            timeline->getAudioPath(),
+                            timeline->getOptions(),
+                            p.player->getInOutRange(),
+                            p.player->getVideoLayer());
+                    }
+                });
+
+            p.cancelButton->setClickedCallback(
+                [this]
+                {
+                    if (auto app = _app.lock())
+                    {
+                        app->getStatsModel()->cancel();
+                    }
+                });
+
+            p.reportEdit->setCallback(
+                [this](const std::filesystem::path& value)
+                {
+                    _p->reportPath = value;
+                });
+
+            p.saveButton->setClickedCallback(
+                [this]
+                {
+                    _save();
+                });
+        }
+
+        StatsTool::StatsTool() :
+            _p(new Private)
+        {}
+
+        StatsTool::~StatsTool()
+        {
+            FTK_P();
+            _saveSettings(p.bellows);
+            p.settings->set("/Statistics/Report", p.reportPath.u8string());
+            if (p.future.valid())
+            {
+                p.future.wait();
+            }
+        }
+
+        std::shared_ptr<StatsTool> StatsTool::create(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::shared_ptr<App>& app,
+            const std::shared_ptr<IWidget>& parent)
+        {
+            auto out = std::shared_ptr<StatsTool>(new StatsTool);
+            out->_init(context, app, parent);
+            return out;
+        }
+
+        void StatsTool::tickEvent(
+            bool parentsVisible,
+            bool parentsEnabled,
+            const ftk::TickEvent& event)
+        {
+            IToolWidget::tickEvent(parentsVisible, parentsEnabled, event);
+            FTK_P();
+
+            // The statistics of the current frame are computed
+            // asynchronously. Frames that arrive while the previous frame is
+            // being computed are skipped, except for the last one.
+            if (p.future.valid() &&
+                p.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+            {
+                p.currentLabel->setText(getText(p.future.get()));
+            }
+            if (p.changed && !p.future.valid())
+            {
+                p.changed = false;
+                if (p.image && !isReadable(p.image->getType()))
+                {
+                    p.currentLabel->setText(getUnreadableText(p.image->getType()));
+                }
+                else if (p.image)
+                {
+                    p.future = std::async(
+                        std::launch::async,
+                        [image = p.image]
+                        {
+                            return getImageStats(image);
+                        });
+                }
+                else
+                {
+                    p.currentLabel->setText(std::string());
+                }
+            }
+        }
+
+        void StatsTool::_sweepUpdate(const StatsSweep& value)
+        {
+            FTK_P();
+            std::string text;
+            switch (value.status)
+            {
+            case StatsSweepStatus::None:
+                break;
+            case StatsSweepStatus::Running:
+                text = ftk::Format("{0}: {1} / {2}").
+                    arg(value.path.get(-1, tl::file::PathType::FileName)).
+                    arg(value.frameCount).
+                    arg(value.frameTotal);
+                break;
+            case StatsSweepStatus::Error:
+                text = ftk::Format("{0}: {1}").
+                    arg(value.path.get(-1, tl::file::PathType::FileName)).
+                    arg(value.error);
+                break;
+            default:
+                text = ftk::Format("{0}: {1}, {2} frames").
+                    arg(value.path.get(-1, tl::file::PathType::FileName)).
+                    arg(getLabel(value.status)).
+                    arg(value.frameCount);
+                if (value.frameErrors > 0)
+                {
+                    text = ftk::Format("{0} ({1} missing or unsupported)").
+                        arg(text).
+                        arg(value.frameErrors);
+                }
+                break;
+            }
+            p.sweepLabel->setText(text);
+            p.cancelButton->setEnabled(StatsSweepStatus::Running == value.status);
+            p.saveButton->setEnabled(
+                value.status != StatsSweepStatus::None &&
+                value.status != StatsSweepStatus::Running &&
+                value.frameCount > 0);
+        }
+
+        void StatsTool::_save()
+        {
+            FTK_P();
+            auto app = _app.lock();
+            auto context = getContext();
+            if (app && context && !p.reportPath.empty())
+            {
+                try
+                {
+                    auto statsModel = app->getStatsModel();
+                    writeStatsReport(
+                        p.reportPath,
+                        statsModel->getSweep().path,
+                        statsModel->getFrames());
+                }
+                catch (const std::exception& e)
+                {
+                    context->getSystem<ftk::DialogSystem>()->message(
+                        "ERROR",
+                        ftk::Format("Error: {0}").arg(e.what()),
+                        getWindow());
+                }
+            }
+        }
+    }
+}
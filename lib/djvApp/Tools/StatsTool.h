@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <djvApp/Tools/IToolWidget.h>
+
+namespace djv
+{
+    namespace app
+    {
+        class App;
+
+        struct StatsSweep;
+
+        //! Statistics tool.
+        //!
+        //! The tool shows the statistics of the current frame, and runs
+        //! sweeps over the in/out range with the statistics model.
+        class StatsTool : public IToolWidget
+        {
+            FTK_NON_COPYABLE(StatsTool);
+
+        protected:
+            void _init(
+                const std::shared_ptr<ftk::Context>&,
+                const std::shared_ptr<App>&,
+                const std::shared_ptr<IWidget>& parent);
+
+            StatsTool();
+
+        public:
+            virtual ~StatsTool();
+
+            static std::shared_ptr<StatsTool> create(
+                const std::shared_ptr<ftk::Context>&,
+                const std::shared_ptr<App>&,
+                const std::shared_ptr<IWidget>& parent = nullptr);
+
+            void tickEvent(
+                bool parentsVisible,
+                bool parentsEnabled,
+                const ftk::TickEvent&) override;
+
+        private:
+            void _sweepUpdate(const StatsSweep&);
+            void _save();
+
+            FTK_PRIVATE();
+        };
+    }
+}
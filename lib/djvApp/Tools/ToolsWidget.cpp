@@ -11,10 +11,13 @@
 #include <djvApp/Tools/FilesTool.h>
 #include <djvApp/Tools/InfoTool.h>
 #include <djvApp/Tools/MessagesTool.h>
+#include <djvApp/Tools/ScopesTool.h>
 #include <djvApp/Tools/SettingsTool.h>
+#include <djvApp/Tools/StatsTool.h>
 #include <djvApp/Tools/SystemLogTool.h>
 #include <djvApp/Tools/ViewTool.h>
 #include <djvApp/App.h>
+#include <djvApp/StartupProfiler.h>
 
 #include <ftk/UI/RowLayout.h>
 #include <ftk/UI/StackLayout.h>
@@ -25,7 +28,10 @@ namespace djv
     {
         struct ToolsWidget::Private
         {
+            std::weak_ptr<App> app;
+            std::weak_ptr<MainWindow> mainWindow;
             std::map<Tool, std::shared_ptr<IToolWidget> > toolWidgets;
+            std::vector<std::shared_ptr<IToolWidget> > toolWidgetsRemoved;
             std::shared_ptr<ftk::StackLayout> layout;
             std::shared_ptr<ftk::ValueObserver<Tool> > activeObserver;
         };
@@ -42,31 +48,38 @@ namespace djv
                 parent);
             FTK_P();
 
-            p.toolWidgets[Tool::Audio] = AudioTool::create(context, app);
-            p.toolWidgets[Tool::Color] = ColorTool::create(context, app);
-            p.toolWidgets[Tool::ColorPicker] = ColorPickerTool::create(context, app);
-            p.toolWidgets[Tool::Devices] = DevicesTool::create(context, app);
-            p.toolWidgets[Tool::Export] = ExportTool::create(context, app);
-            p.toolWidgets[Tool::Files] = FilesTool::create(context, app);
-            p.toolWidgets[Tool::Info] = InfoTool::create(context, app);
-            p.toolWidgets[Tool::Messages] = MessagesTool::create(context, app);
-            p.toolWidgets[Tool::Settings] = SettingsTool::create(context, app);
-            p.toolWidgets[Tool::SystemLog] = SystemLogTool::create(context, app);
-            p.toolWidgets[Tool::View] = ViewTool::create(context, app, mainWindow);
+            p.app = app;
+            p.mainWindow = mainWindow;
 
             p.layout = ftk::StackLayout::create(context, shared_from_this());
-            for (const auto& widget : p.toolWidgets)
-            {
-                widget.second->setParent(p.layout);
-            }
+
+            // The log tools are created at startup so they can collect
+            // messages while they are hidden.
+            _getTool(Tool::Messages);
+            _getTool(Tool::SystemLog);
 
             p.activeObserver = ftk::ValueObserver<Tool>::create(
                 app->getToolsModel()->observeActiveTool(),
                 [this](Tool value)
                 {
                     FTK_P();
-                    auto i = p.toolWidgets.find(value);
-                    p.layout->setCurrentWidget(i != p.toolWidgets.end() ? i->second : nullptr);
+                    // Remove the hidden tools. They are destroyed on the next
+                    // tick since this may be called from one of their
+                    // callbacks.
+                    for (auto i = p.toolWidgets.begin(); i != p.toolWidgets.end();)
+                    {
+                        if (i->first != value && !_isPersistent(i->first))
+                        {
+                            i->second->setParent(nullptr);
+                            p.toolWidgetsRemoved.push_back(i->second);
+                            i = p.toolWidgets.erase(i);
+                        }
+                        else
+                        {
+                            ++i;
+                        }
+                    }
+                    p.layout->setCurrentWidget(_getTool(value));
                     setVisible(value != Tool::None);
                 });
         }
@@ -100,5 +113,65 @@ namespace djv
             IWidget::sizeHintEvent(event);
             _setSizeHint(_p->layout->getSizeHint());
         }
+
+        void ToolsWidget::tickEvent(
+            bool parentsVisible,
+            bool parentsEnabled,
+            const ftk::TickEvent& event)
+        {
+            IWidget::tickEvent(parentsVisible, parentsEnabled, event);
+            _p->toolWidgetsRemoved.clear();
+        }
+
+        bool ToolsWidget::_isPersistent(Tool value) const
+        {
+            return
+                Tool::Messages == value ||
+                Tool::SystemLog == value;
+        }
+
+        std::shared_ptr<IToolWidget> ToolsWidget::_getTool(Tool value)
+        {
+            FTK_P();
+            std::shared_ptr<IToolWidget> out;
+            const auto i = p.toolWidgets.find(value);
+            if (i != p.toolWidgets.end())
+            {
+                out = i->second;
+            }
+            else
+            {
+                auto context = getContext();
+                auto app = p.app.lock();
+                auto mainWindow = p.mainWindow.lock();
+                if (context && app && mainWindow)
+                {
+                    StartupProfilerScope scope(context, to_string(value), "Tools");
+                    switch (value)
+                    {
+                    case Tool::Files: out = FilesTool::create(context, app); break;
+                    case Tool::Export: out = ExportTool::create(context, app); break;
+                    case Tool::View: out = ViewTool::create(context, app, mainWindow); break;
+                    case Tool::Color: out = ColorTool::create(context, app); break;
+                    case Tool::ColorPicker: out = ColorPickerTool::create(context, app); break;
+                    case Tool::Scopes: out = ScopesTool::create(context, app); break;
+                    case Tool::Statistics: out = StatsTool::create(context, app); break;
+                    case Tool::Info: out = InfoTool::create(context, app); break;
+                    case Tool::Audio: out = AudioTool::create(context, app); break;
+                    case Tool::Devices: out = DevicesTool::create(context, app); break;
+                    case Tool::Settings: out = SettingsTool::create(context, app); break;
+                    case Tool::Messages: out = MessagesTool::create(context, app); break;
+                    case Tool::SystemLog: out = SystemLogTool::create(context, app); break;
+                    default: break;
+                    }
+                    if (out)
+                    {
+                        out->setParent(p.layout);
+                        p.toolWidgets[value] = out;
+                    }
+                }
+            }
+            return out;
+        }
     }
 }
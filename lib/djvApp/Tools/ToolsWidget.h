@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <djvApp/Models/ToolsModel.h>
+
 #include <ftk/UI/IWidget.h>
 
 namespace djv
@@ -10,9 +12,15 @@ namespace djv
     namespace app
     {
         class App;
+        class IToolWidget;
         class MainWindow;
 
         //! Tools widget.
+        //!
+        //! The tools are created when they are shown, and destroyed when they
+        //! are hidden so their observers are detached. Only the messages and
+        //! system log tools are kept, since they are created at startup to
+        //! collect log items while they are hidden.
         class ToolsWidget : public ftk::IWidget
         {
             FTK_NON_COPYABLE(ToolsWidget);
@@ -38,8 +46,15 @@ namespace djv
 
             void setGeometry(const ftk::Box2I&) override;
             void sizeHintEvent(const ftk::SizeHintEvent&) override;
+            void tickEvent(
+                bool,
+                bool,
+                const ftk::TickEvent&) override;
 
         private:
+            bool _isPersistent(Tool) const;
+            std::shared_ptr<IToolWidget> _getTool(Tool);
+
             FTK_PRIVATE();
         };
     }
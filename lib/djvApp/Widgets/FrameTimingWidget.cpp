@@ -0,0 +1,179 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djvApp/Widgets/FrameTimingWidget.h>
+
+#include <algorithm>
+#include <optional>
+
+namespace djv
+{
+    namespace app
+    {
+        namespace
+        {
+            const size_t samplesMax = 120;
+
+            FrameTimingPercentiles getPercentiles(std::vector<double> values)
+            {
+                FrameTimingPercentiles out;
+                if (!values.empty())
+                {
+                    std::sort(values.begin(), values.end());
+                    const size_t last = values.size() - 1;
+                    out.p50 = values[last * 50 / 100];
+                    out.p95 = values[last * 95 / 100];
+                    out.p99 = values[last * 99 / 100];
+                }
+                return out;
+            }
+        }
+
+        FrameTimingPercentiles getIntervalPercentiles(const std::vector<FrameTiming>& value)
+        {
+            std::vector<double> values;
+            values.reserve(value.size());
+            for (const auto& i : value)
+            {
+                values.push_back(i.interval);
+            }
+            return getPercentiles(values);
+        }
+
+        FrameTimingPercentiles getDrawPercentiles(const std::vector<FrameTiming>& value)
+        {
+            std::vector<double> values;
+            values.reserve(value.size());
+            for (const auto& i : value)
+            {
+                values.push_back(i.draw);
+            }
+            return getPercentiles(values);
+        }
+
+        struct FrameTimingWidget::Private
+        {
+            std::vector<FrameTiming> samples;
+            FrameTimingPercentiles percentiles;
+
+            struct SizeData
+            {
+                std::optional<float> displayScale;
+                int barWidth = 0;
+                int height = 0;
+            };
+            SizeData size;
+        };
+
+        void FrameTimingWidget::_init(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::shared_ptr<IWidget>& parent)
+        {
+            IWidget::_init(context, "djv::app::FrameTimingWidget", parent);
+            _p->samples.reserve(samplesMax);
+        }
+
+        FrameTimingWidget::FrameTimingWidget() :
+            _p(new Private)
+        {}
+
+        FrameTimingWidget::~FrameTimingWidget()
+        {}
+
+        std::shared_ptr<FrameTimingWidget> FrameTimingWidget::create(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::shared_ptr<IWidget>& parent)
+        {
+            auto out = std::shared_ptr<FrameTimingWidget>(new FrameTimingWidget);
+            out->_init(context, parent);
+            return out;
+        }
+
+        const std::vector<FrameTiming>& FrameTimingWidget::getSamples() const
+        {
+            return _p->samples;
+        }
+
+        void FrameTimingWidget::addSample(const FrameTiming& value)
+        {
+            FTK_P();
+            if (p.samples.size() >= samplesMax)
+            {
+                p.samples.erase(p.samples.begin());
+            }
+            p.samples.push_back(value);
+            p.percentiles = getIntervalPercentiles(p.samples);
+            setDrawUpdate();
+        }
+
+        void FrameTimingWidget::setDrawTime(double value)
+        {
+            FTK_P();
+            if (!p.samples.empty())
+            {
+                p.samples.back().draw = value;
+                setDrawUpdate();
+            }
+        }
+
+        void FrameTimingWidget::clear()
+        {
+            FTK_P();
+            p.samples.clear();
+            p.percentiles = FrameTimingPercentiles();
+            setDrawUpdate();
+        }
+
+        void FrameTimingWidget::sizeHintEvent(const ftk::SizeHintEvent& event)
+        {
+            IWidget::sizeHintEvent(event);
+            FTK_P();
+            if (!p.size.displayScale.has_value() ||
+                (p.size.displayScale.has_value() && p.size.displayScale.value() != event.displayScale))
+            {
+                p.size.displayScale = event.displayScale;
+                p.size.barWidth = std::max(1, static_cast<int>(2 * event.displayScale));
+                p.size.height = 48 * event.displayScale;
+            }
+            _setSizeHint(ftk::Size2I(p.size.barWidth * samplesMax, p.size.height));
+        }
+
+        void FrameTimingWidget::drawEvent(const ftk::Box2I& drawRect, const ftk::DrawEvent& event)
+        {
+            IWidget::drawEvent(drawRect, event);
+            FTK_P();
+            const ftk::Box2I& g = getGeometry();
+            event.render->drawRect(g, event.style->getColorRole(ftk::ColorRole::Overlay));
+            if (p.samples.empty())
+                return;
+
+            // The graph is scaled to fit the 99th percentile with some head
+            // room, so that single long frames do not flatten the graph.
+            const double scale = g.h() / std::max(p.percentiles.p99 * 1.25, 1.0);
+            const ftk::Color4F hitColor(.3F, .8F, .3F);
+            const ftk::Color4F missColor(.9F, .3F, .3F);
+            const ftk::Color4F drawColor(.3F, .5F, .9F);
+            int x = g.max.x + 1 - static_cast<int>(p.samples.size()) * p.size.barWidth;
+            for (const auto& sample : p.samples)
+            {
+                const int h = std::min(g.h(), static_cast<int>(sample.interval * scale));
+                event.render->drawRect(
+                    ftk::Box2I(x, g.max.y + 1 - h, p.size.barWidth, h),
+                    0 == sample.skipped ? hitColor : missColor);
+                const int h2 = std::min(h, static_cast<int>(sample.draw * scale));
+                event.render->drawRect(
+                    ftk::Box2I(x, g.max.y + 1 - h2, p.size.barWidth, h2),
+                    drawColor);
+                x += p.size.barWidth;
+            }
+
+            // Draw the percentile lines.
+            const ftk::Color4F lineColor(1.F, 1.F, 1.F, .5F);
+            for (double value : { p.percentiles.p95, p.percentiles.p99 })
+            {
+                const int y = g.max.y - std::min(g.h() - 1, static_cast<int>(value * scale));
+                event.render->drawRect(ftk::Box2I(g.min.x, y, g.w(), 1), lineColor);
+            }
+        }
+    }
+}
@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <ftk/UI/IWidget.h>
+
+namespace djv
+{
+    namespace app
+    {
+        //! Frame timing.
+        struct FrameTiming
+        {
+            //! Time since the previous frame in milliseconds.
+            double interval = 0.0;
+
+            //! CPU time taken to draw the frame in milliseconds, including
+            //! submitting the texture uploads. This does not include the time
+            //! the GPU takes to finish the work.
+            double draw = 0.0;
+
+            //! Number of frames skipped before the frame because they were
+            //! not ready in time.
+            int64_t skipped = 0;
+
+            //! Number of frames cached ahead of the frame.
+            int64_t cacheAhead = 0;
+        };
+
+        //! Frame timing percentiles.
+        struct FrameTimingPercentiles
+        {
+            double p50 = 0.0;
+            double p95 = 0.0;
+            double p99 = 0.0;
+        };
+
+        //! Get the percentiles of the frame intervals.
+        FrameTimingPercentiles getIntervalPercentiles(const std::vector<FrameTiming>&);
+
+        //! Get the percentiles of the CPU draw times.
+        FrameTimingPercentiles getDrawPercentiles(const std::vector<FrameTiming>&);
+
+        //! Frame timing graph.
+        //!
+        //! The graph shows a bar for each recent frame. The height of the
+        //! bar is the frame interval, the lower part is the CPU draw time,
+        //! and frames that follow skipped frames are shown in red. The lines
+        //! are the 95th and 99th percentiles of the frame interval.
+        class FrameTimingWidget : public ftk::IWidget
+        {
+            FTK_NON_COPYABLE(FrameTimingWidget);
+
+        protected:
+            void _init(
+                const std::shared_ptr<ftk::Context>&,
+                const std::shared_ptr<IWidget>& parent);
+
+            FrameTimingWidget();
+
+        public:
+            virtual ~FrameTimingWidget();
+
+            static std::shared_ptr<FrameTimingWidget> create(
+                const std::shared_ptr<ftk::Context>&,
+                const std::shared_ptr<IWidget>& parent = nullptr);
+
+            //! Get the samples.
+            const std::vector<FrameTiming>& getSamples() const;
+
+            //! Add a sample. The oldest sample is removed when the maximum
+            //! number of samples is reached.
+            void addSample(const FrameTiming&);
+
+            //! Set the CPU draw time of the newest sample.
+            void setDrawTime(double);
+
+            //! Clear the samples.
+            void clear();
+
+            void sizeHintEvent(const ftk::SizeHintEvent&) override;
+            void drawEvent(const ftk::Box2I&, const ftk::DrawEvent&) override;
+
+        private:
+            FTK_PRIVATE();
+        };
+    }
+}
@@ -7,17 +7,58 @@
 #include <djvApp/App.h>
 
 #include <ftk/UI/TabBar.h>
+#include <ftk/Core/Format.h>
 #include <ftk/Core/String.h>
 
 namespace djv
 {
     namespace app
     {
+        namespace
+        {
+            struct Tab
+            {
+                std::string text;
+                std::string tooltip;
+
+                bool operator == (const Tab& other) const
+                {
+                    return text == other.text && tooltip == other.tooltip;
+                }
+            };
+
+            Tab getTab(const FilesModelItem& item)
+            {
+                Tab out;
+                out.text = ftk::elide(item.path.get(-1, tl::file::PathType::FileName));
+                out.tooltip = item.path.get();
+                const FilesModelLoadState& load = item.load->get();
+                switch (load.status)
+                {
+                case FilesModelLoad::Queued:
+                case FilesModelLoad::Loading:
+                    out.text = ftk::Format("{0} (Loading)").arg(out.text);
+                    break;
+                case FilesModelLoad::Error:
+                    out.text = ftk::Format("{0} (Error)").arg(out.text);
+                    out.tooltip = ftk::Format("{0}\n\nError: {1}").arg(out.tooltip).arg(load.error);
+                    break;
+                default: break;
+                }
+                return out;
+            }
+        }
+
         struct TabBar::Private
         {
             int aIndex = -1;
+            std::vector<std::shared_ptr<FilesModelItem> > files;
+            std::vector<Tab> tabs;
+            bool filesInit = false;
+            bool tabsUpdate = false;
             std::shared_ptr<ftk::TabBar> tabBar;
             std::shared_ptr<ftk::ListObserver<std::shared_ptr<FilesModelItem> > > filesObserver;
+            std::vector<std::shared_ptr<ftk::ValueObserver<FilesModelLoadState> > > loadObservers;
             std::shared_ptr<ftk::ValueObserver<int> > aIndexObserver;
         };
 
@@ -55,14 +96,25 @@ namespace djv
                 [this](const std::vector<std::shared_ptr<FilesModelItem> >& value)
                 {
                     FTK_P();
-                    p.tabBar->clearTabs();
-                    for (const auto& item : value)
+                    p.files = value;
+                    p.tabs.clear();
+                    p.filesInit = true;
+                    p.loadObservers.clear();
+                    for (size_t i = 0; i < value.size(); ++i)
                     {
-                        p.tabBar->addTab(
-                            ftk::elide(item->path.get(-1, tl::file::PathType::FileName)),
-                            item->path.get());
+                        p.tabs.push_back(getTab(*value[i]));
+                        p.loadObservers.push_back(ftk::ValueObserver<FilesModelLoadState>::create(
+                            value[i]->load,
+                            [this, i](const FilesModelLoadState&)
+                            {
+                                if (!_p->filesInit)
+                                {
+                                    _tabUpdate(i);
+                                }
+                            }));
                     }
-                    p.tabBar->setCurrentTab(p.aIndex);
+                    p.filesInit = false;
+                    _tabsUpdate();
                 });
 
             p.aIndexObserver = ftk::ValueObserver<int>::create(
@@ -98,10 +150,53 @@ namespace djv
             _p->tabBar->setGeometry(value);
         }
 
+        void TabBar::tickEvent(
+            bool parentsVisible,
+            bool parentsEnabled,
+            const ftk::TickEvent& event)
+        {
+            IWidget::tickEvent(parentsVisible, parentsEnabled, event);
+            FTK_P();
+            if (p.tabsUpdate)
+            {
+                _tabsUpdate();
+            }
+        }
+
         void TabBar::sizeHintEvent(const ftk::SizeHintEvent& event)
         {
             IWidget::sizeHintEvent(event);
             _setSizeHint(_p->tabBar->getSizeHint());
         }
+
+        void TabBar::_tabUpdate(size_t index)
+        {
+            FTK_P();
+            // Only the tab of the item is checked. The tab bar does not have
+            // functions to change a single tab, so when the text or tooltip
+            // changes the tabs are set once on the next tick, however many
+            // items have changed.
+            if (index < p.files.size() && index < p.tabs.size())
+            {
+                const Tab tab = getTab(*p.files[index]);
+                if (!(tab == p.tabs[index]))
+                {
+                    p.tabs[index] = tab;
+                    p.tabsUpdate = true;
+                }
+            }
+        }
+
+        void TabBar::_tabsUpdate()
+        {
+            FTK_P();
+            p.tabsUpdate = false;
+            p.tabBar->clearTabs();
+            for (const auto& tab : p.tabs)
+            {
+                p.tabBar->addTab(tab.text, tab.tooltip);
+            }
+            p.tabBar->setCurrentTab(p.aIndex);
+        }
     }
 }
@@ -35,9 +35,16 @@ namespace djv
                 const std::shared_ptr<IWidget>& parent = nullptr);
 
             void setGeometry(const ftk::Box2I&) override;
+            void tickEvent(
+                bool parentsVisible,
+                bool parentsEnabled,
+                const ftk::TickEvent&) override;
             void sizeHintEvent(const ftk::SizeHintEvent&) override;
 
         private:
+            void _tabUpdate(size_t);
+            void _tabsUpdate();
+
             FTK_PRIVATE();
         };
     }
@@ -8,23 +8,109 @@
 #include <djvApp/Models/SettingsModel.h>
 #include <djvApp/Models/TimeUnitsModel.h>
 #include <djvApp/Models/ViewportModel.h>
+#include <djvApp/Widgets/FrameTimingWidget.h>
 #include <djvApp/App.h>
+#include <djvApp/ImageUtil.h>
+#include <djvApp/StartupProfiler.h>
 
+#include <tlTimeline/IRender.h>
 #include <tlTimeline/Util.h>
 
+#include <ftk/GL/GL.h>
+#include <ftk/GL/OffscreenBuffer.h>
 #include <ftk/UI/ColorSwatch.h>
 #include <ftk/UI/GridLayout.h>
 #include <ftk/UI/Label.h>
 #include <ftk/UI/RowLayout.h>
 #include <ftk/UI/Spacer.h>
 #include <ftk/Core/Format.h>
+#include <ftk/Core/Matrix.h>
+#include <ftk/Core/RenderUtil.h>
 
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <optional>
 #include <regex>
 
 namespace djv
 {
     namespace app
     {
+        namespace
+        {
+            // The frame timing text is updated a few times a second, so it
+            // can be read and it does not add work to every frame.
+            const std::chrono::milliseconds timingLabelInterval(250);
+
+            // Get the average, minimum, and maximum of RGBA float pixels.
+            ColorPickerSample getColorPickerSample(const float* data, size_t count, int size)
+            {
+                ColorPickerSample out;
+                out.size = size;
+                if (count > 0)
+                {
+                    float sum[4] = { 0.F, 0.F, 0.F, 0.F };
+                    float min[4];
+                    float max[4];
+                    for (size_t c = 0; c < 4; ++c)
+                    {
+                        min[c] = std::numeric_limits<float>::max();
+                        max[c] = std::numeric_limits<float>::lowest();
+                    }
+                    for (size_t i = 0; i < count; ++i, data += 4)
+                    {
+                        for (size_t c = 0; c < 4; ++c)
+                        {
+                            sum[c] += data[c];
+                            min[c] = std::min(min[c], data[c]);
+                            max[c] = std::max(max[c], data[c]);
+                        }
+                    }
+                    out.color = ftk::Color4F(sum[0] / count, sum[1] / count, sum[2] / count, sum[3] / count);
+                    out.min = ftk::Color4F(min[0], min[1], min[2], min[3]);
+                    out.max = ftk::Color4F(max[0], max[1], max[2], max[3]);
+                }
+                return out;
+            }
+
+            // Get a sample from an area of an image in memory.
+            bool getSourceSample(
+                const std::shared_ptr<ftk::Image>& image,
+                const ftk::Box2I& area,
+                ColorPickerSample& sample)
+            {
+                if (!isReadable(image->getType()))
+                {
+                    sample.sourceError = getUnreadableText(image->getType());
+                    return false;
+                }
+                const ftk::Box2I box = ftk::intersect(
+                    area,
+                    ftk::Box2I(0, 0, image->getWidth(), image->getHeight()));
+                if (!box.isValid())
+                    return false;
+
+                std::vector<float> rgba(static_cast<size_t>(box.w()) * box.h() * 4);
+                for (int y = box.min.y; y <= box.max.y; ++y)
+                {
+                    readPixels(
+                        image,
+                        box.min.x,
+                        y,
+                        box.w(),
+                        1,
+                        rgba.data() + static_cast<size_t>(y - box.min.y) * box.w() * 4);
+                }
+                const ColorPickerSample tmp = getColorPickerSample(rgba.data(), rgba.size() / 4, 1);
+                sample.source = true;
+                sample.sourceColor = tmp.color;
+                sample.sourceMin = tmp.min;
+                sample.sourceMax = tmp.max;
+                return true;
+            }
+        }
+
         struct Viewport::Private
         {
             std::weak_ptr<App> app;
@@ -36,7 +122,24 @@ namespace djv
             size_t videoDataSize = 0;
             ftk::ImageOptions imageOptions;
             tl::timeline::DisplayOptions displayOptions;
-            ftk::Color4F colorPicker;
+            ColorPickerSample colorPicker;
+            int colorPickerSize = 1;
+            ColorPickerMode colorPickerMode = ColorPickerMode::Display;
+            std::vector<tl::timeline::VideoData> videoData;
+            bool colorPickerRequest = false;
+            ftk::V2I colorPickerPos;
+            std::optional<ftk::V2I> colorPickerSourcePos;
+#if defined(FTK_API_GL_4_1)
+            struct ColorPickerReadback
+            {
+                GLuint pbo = 0;
+                GLsync fence = nullptr;
+                size_t count = 0;
+                int size = 1;
+            };
+            ColorPickerReadback colorPickerReadback;
+#endif // FTK_API_GL_4_1
+            std::shared_ptr<ftk::gl::OffscreenBuffer> colorPickerBuffer;
             tl::timeline::PlayerCacheInfo cacheInfo;
             MouseActionBinding colorPickerBinding = MouseActionBinding(1);
             MouseActionBinding frameShuttleBinding = MouseActionBinding(1, ftk::KeyModifier::Shift);
@@ -47,6 +150,20 @@ namespace djv
             std::shared_ptr<ftk::Label> colorPickerLabel;
             std::shared_ptr<ftk::Label> cacheLabel;
             std::shared_ptr<ftk::GridLayout> hudLayout;
+            std::shared_ptr<FilesModelItem> a;
+            std::shared_ptr<ftk::Label> loadLabel;
+            ftk::Size2I loadLabelSizeHint;
+            bool firstDraw = true;
+            bool startupProfiling = true;
+            bool hudGraph = false;
+            std::optional<std::chrono::steady_clock::time_point> timingPrev;
+            std::optional<std::chrono::steady_clock::time_point> timingLabelTime;
+            std::optional<OTIO_NS::RationalTime> timingTime;
+            bool timingDraw = false;
+
+            std::shared_ptr<FrameTimingWidget> timingWidget;
+            std::shared_ptr<ftk::Label> timingLabel;
+            std::shared_ptr<ftk::VerticalLayout> timingLayout;
 
             std::shared_ptr<ftk::ValueObserver<OTIO_NS::RationalTime> > currentTimeObserver;
             std::shared_ptr<ftk::ListObserver<tl::timeline::VideoData> > videoDataObserver;
@@ -56,15 +173,20 @@ namespace djv
             std::shared_ptr<ftk::ValueObserver<tl::timeline::CompareOptions> > compareOptionsObserver;
             std::shared_ptr<ftk::ValueObserver<tl::timeline::OCIOOptions> > ocioOptionsObserver;
             std::shared_ptr<ftk::ValueObserver<tl::timeline::LUTOptions> > lutOptionsObserver;
-            std::shared_ptr<ftk::ValueObserver<ftk::Color4F> > colorPickerObserver;
+            std::shared_ptr<ftk::ValueObserver<ColorPickerSample> > colorPickerObserver;
+            std::shared_ptr<ftk::ValueObserver<int> > colorPickerSizeObserver;
+            std::shared_ptr<ftk::ValueObserver<ColorPickerMode> > colorPickerModeObserver;
             std::shared_ptr<ftk::ValueObserver<ftk::ImageOptions> > imageOptionsObserver;
             std::shared_ptr<ftk::ValueObserver<tl::timeline::DisplayOptions> > displayOptionsObserver;
             std::shared_ptr<ftk::ValueObserver<tl::timeline::BackgroundOptions> > bgOptionsObserver;
             std::shared_ptr<ftk::ValueObserver<tl::timeline::ForegroundOptions> > fgOptionsObserver;
             std::shared_ptr<ftk::ValueObserver<ftk::ImageType> > colorBufferObserver;
             std::shared_ptr<ftk::ValueObserver<bool> > hudObserver;
+            std::shared_ptr<ftk::ValueObserver<bool> > hudGraphObserver;
             std::shared_ptr<ftk::ValueObserver<tl::timeline::TimeUnits> > timeUnitsObserver;
             std::shared_ptr<ftk::ValueObserver<MouseSettings> > mouseSettingsObserver;
+            std::shared_ptr<ftk::ValueObserver<std::shared_ptr<FilesModelItem> > > aObserver;
+            std::shared_ptr<ftk::ValueObserver<FilesModelLoadState> > aLoadObserver;
 
             enum class MouseMode
             {
@@ -134,6 +256,23 @@ namespace djv
             p.cacheLabel->setParent(p.hudLayout);
             p.hudLayout->setGridPos(p.cacheLabel, 2, 2);
 
+            p.timingLayout = ftk::VerticalLayout::create(context, p.hudLayout);
+            p.hudLayout->setGridPos(p.timingLayout, 1, 2);
+            p.timingLayout->setMarginRole(ftk::SizeRole::MarginInside);
+            p.timingLayout->setSpacingRole(ftk::SizeRole::SpacingSmall);
+            p.timingLayout->setBackgroundRole(ftk::ColorRole::Overlay);
+            p.timingLayout->setHAlign(ftk::HAlign::Right);
+            p.timingLayout->setVAlign(ftk::VAlign::Top);
+            p.timingWidget = FrameTimingWidget::create(context, p.timingLayout);
+            p.timingLabel = ftk::Label::create(context, p.timingLayout);
+            p.timingLabel->setFontRole(ftk::FontRole::Mono);
+            p.timingLayout->hide();
+
+            p.loadLabel = ftk::Label::create(context, shared_from_this());
+            p.loadLabel->setMarginRole(ftk::SizeRole::Margin);
+            p.loadLabel->setBackgroundRole(ftk::ColorRole::Overlay);
+            p.loadLabel->hide();
+
             p.fpsObserver = ftk::ValueObserver<double>::create(
                 observeFPS(),
                 [this](double value)
@@ -171,14 +310,29 @@ namespace djv
                    setLUTOptions(value);
                 });
 
-            p.colorPickerObserver = ftk::ValueObserver<ftk::Color4F>::create(
+            p.colorPickerObserver = ftk::ValueObserver<ColorPickerSample>::create(
                 app->getViewportModel()->observeColorPicker(),
-                [this](const ftk::Color4F& value)
+                [this](const ColorPickerSample& value)
                 {
                     _p->colorPicker = value;
                     _hudUpdate();
                 });
 
+            p.colorPickerSizeObserver = ftk::ValueObserver<int>::create(
+                app->getViewportModel()->observeColorPickerSize(),
+                [this](int value)
+                {
+                    _p->colorPickerSize = value;
+                });
+
+            p.colorPickerModeObserver = ftk::ValueObserver<ColorPickerMode>::create(
+                app->getViewportModel()->observeColorPickerMode(),
+                [this](ColorPickerMode value)
+                {
+                    _p->colorPickerMode = value;
+                    _hudUpdate();
+                });
+
             p.imageOptionsObserver = ftk::ValueObserver<ftk::ImageOptions>::create(
                 app->getViewportModel()->observeImageOptions(),
                 [this](const ftk::ImageOptions& value)
@@ -222,9 +376,41 @@ namespace djv
                 [this](bool value)
                 {
                     _p->hud = value;
+                    _timingReset();
+                    _hudUpdate();
+                });
+
+            p.hudGraphObserver = ftk::ValueObserver<bool>::create(
+                app->getViewportModel()->observeHUDGraph(),
+                [this](bool value)
+                {
+                    _p->hudGraph = value;
+                    _timingReset();
                     _hudUpdate();
                 });
 
+            p.aObserver = ftk::ValueObserver<std::shared_ptr<FilesModelItem> >::create(
+                app->getFilesModel()->observeA(),
+                [this](const std::shared_ptr<FilesModelItem>& value)
+                {
+                    FTK_P();
+                    p.a = value;
+                    if (value)
+                    {
+                        p.aLoadObserver = ftk::ValueObserver<FilesModelLoadState>::create(
+                            value->load,
+                            [this](const FilesModelLoadState&)
+                            {
+                                _loadUpdate();
+                            });
+                    }
+                    else
+                    {
+                        p.aLoadObserver.reset();
+                        _loadUpdate();
+                    }
+                });
+
             p.timeUnitsObserver = ftk::ValueObserver<tl::timeline::TimeUnits>::create(
                 app->getTimeUnitsModel()->observeTimeUnits(),
                 [this](tl::timeline::TimeUnits value)
@@ -256,7 +442,19 @@ namespace djv
         {}
 
         Viewport::~Viewport()
-        {}
+        {
+#if defined(FTK_API_GL_4_1)
+            FTK_P();
+            if (p.colorPickerReadback.fence)
+            {
+                glDeleteSync(p.colorPickerReadback.fence);
+            }
+            if (p.colorPickerReadback.pbo)
+            {
+                glDeleteBuffers(1, &p.colorPickerReadback.pbo);
+            }
+#endif // FTK_API_GL_4_1
+        }
 
         std::shared_ptr<Viewport> Viewport::create(
             const std::shared_ptr<ftk::Context>& context,
@@ -288,8 +486,20 @@ namespace djv
                     player->observeCurrentVideo(),
                     [this](const std::vector<tl::timeline::VideoData>& value)
                     {
+                        _p->videoData = value;
                         _p->videoDataSize = value.size();
                         _videoDataUpdate();
+
+                        // Sample the new frame at the last position, so the
+                        // source sample follows playback.
+                        if (_p->colorPickerSourcePos.has_value())
+                        {
+                            _colorPickerSource(_p->colorPickerSourcePos.value());
+                        }
+                        if (_p->hud && _p->hudGraph)
+                        {
+                            _timingSample();
+                        }
                     });
 
                 p.cacheObserver = ftk::ValueObserver<tl::timeline::PlayerCacheInfo>::create(
@@ -306,9 +516,11 @@ namespace djv
                 p.currentTime = tl::time::invalidTime;
                 p.currentTimeObserver.reset();
                 p.videoDataObserver.reset();
+                p.videoData.clear();
                 p.cacheInfo = tl::timeline::PlayerCacheInfo();
                 p.cacheObserver.reset();
                 p.videoDataObserver.reset();
+                _timingReset();
                 _hudUpdate();
             }
         }
@@ -318,6 +530,7 @@ namespace djv
             tl::timelineui::Viewport::setGeometry(value);
             FTK_P();
             p.hudLayout->setGeometry(value);
+            _loadLabelGeometry();
         }
 
         void Viewport::sizeHintEvent(const ftk::SizeHintEvent& event)
@@ -325,6 +538,13 @@ namespace djv
             tl::timelineui::Viewport::sizeHintEvent(event);
             FTK_P();
             _setSizeHint(p.hudLayout->getSizeHint());
+
+            // The label size changes with the text, so the geometry is also
+            // updated here after the label size hint is computed.
+            if (p.loadLabel->getSizeHint() != p.loadLabelSizeHint)
+            {
+                _loadLabelGeometry();
+            }
         }
 
         void Viewport::mouseMoveEvent(ftk::MouseMoveEvent& event)
@@ -353,11 +573,7 @@ namespace djv
                 }
                 break;
             case Private::MouseMode::ColorPicker:
-                if (auto app = p.app.lock())
-                {
-                    const ftk::Color4F color = getColorSample(event.pos);
-                    app->getViewportModel()->setColorPicker(color);
-                }
+                _colorPickerRequest(event.pos);
                 break;
             default: break;
             }
@@ -371,11 +587,7 @@ namespace djv
                 ftk::checkKeyModifier(p.colorPickerBinding.modifier, event.modifiers))
             {
                 p.mouse.mode = Private::MouseMode::ColorPicker;
-                if (auto app = p.app.lock())
-                {
-                    const ftk::Color4F color = getColorSample(event.pos);
-                    app->getViewportModel()->setColorPicker(color);
-                }
+                _colorPickerRequest(event.pos);
             }
             else if (p.frameShuttleBinding.button == event.button &&
                 ftk::checkKeyModifier(p.frameShuttleBinding.modifier, event.modifiers))
@@ -396,6 +608,303 @@ namespace djv
             p.mouse = Private::MouseData();
         }
 
+        void Viewport::tickEvent(
+            bool parentsVisible,
+            bool parentsEnabled,
+            const ftk::TickEvent& event)
+        {
+            tl::timelineui::Viewport::tickEvent(parentsVisible, parentsEnabled, event);
+#if defined(FTK_API_GL_4_1)
+            FTK_P();
+            // Draw again to get the result of the color picker readback.
+            if (p.colorPickerReadback.fence)
+            {
+                _setDrawUpdate();
+            }
+#endif // FTK_API_GL_4_1
+        }
+
+        void Viewport::drawEvent(const ftk::Box2I& drawRect, const ftk::DrawEvent& event)
+        {
+            FTK_P();
+            if (p.timingDraw)
+            {
+                // Time the first draw of a new frame, which includes
+                // uploading the textures. This is the CPU time, the GPU
+                // may still be working when the draw returns.
+                p.timingDraw = false;
+                const auto t0 = std::chrono::steady_clock::now();
+                tl::timelineui::Viewport::drawEvent(drawRect, event);
+                const std::chrono::duration<double, std::milli> diff =
+                    std::chrono::steady_clock::now() - t0;
+                p.timingWidget->setDrawTime(diff.count());
+            }
+            else
+            {
+                tl::timelineui::Viewport::drawEvent(drawRect, event);
+            }
+            _colorPickerDraw(event);
+            if (p.startupProfiling)
+            {
+                _startupProfile();
+            }
+        }
+
+        void Viewport::_colorPickerRequest(const ftk::V2I& pos)
+        {
+            FTK_P();
+            auto app = p.app.lock();
+            if (!app)
+                return;
+
+            if (ColorPickerMode::Source == p.colorPickerMode ||
+                ColorPickerMode::Both == p.colorPickerMode)
+            {
+                p.colorPickerSourcePos = pos;
+                _colorPickerSource(pos);
+            }
+
+            // The display sample is read when the viewport is drawn, so that
+            // mouse moves are coalesced to one sample per frame.
+            if (ColorPickerMode::Display == p.colorPickerMode ||
+                ColorPickerMode::Both == p.colorPickerMode)
+            {
+                p.colorPickerPos = pos;
+                p.colorPickerRequest = true;
+                _setDrawUpdate();
+            }
+        }
+
+        void Viewport::_colorPickerSource(const ftk::V2I& pos)
+        {
+            FTK_P();
+            auto app = p.app.lock();
+            if (!app ||
+                (p.colorPickerMode != ColorPickerMode::Source &&
+                    p.colorPickerMode != ColorPickerMode::Both))
+                return;
+
+            // Sample the source image. The cursor is mapped to image
+            // coordinates using the view position and zoom, and then the
+            // display mirroring is undone. The image coordinates are mapped
+            // to memory with the image layout mirroring.
+            ColorPickerSample sample = app->getViewportModel()->getColorPicker();
+            sample.source = false;
+            sample.sourceError.clear();
+            if (!p.videoData.empty() && !p.videoData.front().layers.empty())
+            {
+                if (const auto& image = p.videoData.front().layers.front().image)
+                {
+                    const ftk::Box2I& g = getGeometry();
+                    const ftk::V2I& viewPos = getViewPos();
+                    const double zoom = getViewZoom();
+                    const ftk::ImageInfo& info = image->getInfo();
+                    if (zoom > 0.0 && info.pixelAspectRatio > 0.F)
+                    {
+                        ftk::V2I imagePos(
+                            static_cast<int>(std::floor((pos.x - g.min.x - viewPos.x) / zoom / info.pixelAspectRatio)),
+                            static_cast<int>(std::floor((pos.y - g.min.y - viewPos.y) / zoom)));
+                        if (p.displayOptions.mirror.x)
+                        {
+                            imagePos.x = info.size.w - 1 - imagePos.x;
+                        }
+                        if (p.displayOptions.mirror.y)
+                        {
+                            imagePos.y = info.size.h - 1 - imagePos.y;
+                        }
+                        sample.sourcePos = imagePos;
+                        ftk::V2I memoryPos = imagePos;
+                        if (info.layout.mirror.x)
+                        {
+                            memoryPos.x = info.size.w - 1 - memoryPos.x;
+                        }
+                        if (info.layout.mirror.y)
+                        {
+                            memoryPos.y = info.size.h - 1 - memoryPos.y;
+                        }
+                        const int size = std::max(1, p.colorPickerSize);
+                        sample.size = size;
+                        getSourceSample(
+                            image,
+                            ftk::Box2I(
+                                memoryPos.x - size / 2,
+                                memoryPos.y - size / 2,
+                                size,
+                                size),
+                            sample);
+                    }
+                }
+            }
+            app->getViewportModel()->setColorPicker(sample);
+        }
+
+        void Viewport::_colorPickerDraw(const ftk::DrawEvent& event)
+        {
+            FTK_P();
+            auto app = p.app.lock();
+            if (!app)
+                return;
+
+#if defined(FTK_API_GL_4_1)
+            // Get the result of the previous readback.
+            auto& readback = p.colorPickerReadback;
+            if (readback.fence)
+            {
+                const GLenum result = glClientWaitSync(readback.fence, 0, 0);
+                if (GL_ALREADY_SIGNALED == result ||
+                    GL_CONDITION_SATISFIED == result ||
+                    GL_WAIT_FAILED == result)
+                {
+                    if (GL_WAIT_FAILED != result)
+                    {
+                        glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+                        if (void* data = glMapBufferRange(
+                            GL_PIXEL_PACK_BUFFER,
+                            0,
+                            readback.count * 4 * sizeof(float),
+                            GL_MAP_READ_BIT))
+                        {
+                            _colorPickerDisplay(getColorPickerSample(
+                                reinterpret_cast<const float*>(data),
+                                readback.count,
+                                readback.size));
+                            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+                        }
+                        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+                    }
+                    glDeleteSync(readback.fence);
+                    readback.fence = nullptr;
+                }
+            }
+#endif // FTK_API_GL_4_1
+
+            // Start a new readback. Only one readback is in flight at a
+            // time, the latest mouse position is used when it finishes.
+#if defined(FTK_API_GL_4_1)
+            if (p.colorPickerRequest && !readback.fence)
+#else // FTK_API_GL_4_1
+            if (p.colorPickerRequest)
+#endif // FTK_API_GL_4_1
+            {
+                p.colorPickerRequest = false;
+                const ftk::Box2I& g = getGeometry();
+                const int size = std::max(1, p.colorPickerSize);
+                const ftk::Box2I box = ftk::intersect(
+                    ftk::Box2I(
+                        p.colorPickerPos.x - size / 2,
+                        p.colorPickerPos.y - size / 2,
+                        size,
+                        size),
+                    g);
+                auto render = std::dynamic_pointer_cast<tl::timeline::IRender>(event.render);
+                if (box.isValid() && render && !p.videoData.empty())
+                {
+                    // Render the area into an offscreen buffer with the
+                    // color buffer type of the viewport, so the sample has
+                    // the same precision as the viewport and does not
+                    // include the HUD or other widgets drawn on top.
+                    const ftk::Size2I bufferSize(box.w(), box.h());
+                    ftk::gl::OffscreenBufferOptions bufferOptions;
+                    bufferOptions.color = app->getViewportModel()->getColorBuffer();
+                    if (ftk::gl::doCreate(p.colorPickerBuffer, bufferSize, bufferOptions))
+                    {
+                        p.colorPickerBuffer = ftk::gl::OffscreenBuffer::create(bufferSize, bufferOptions);
+                    }
+                    ftk::gl::OffscreenBufferBinding binding(p.colorPickerBuffer);
+                    ftk::RenderSizeState renderSizeState(render);
+                    ftk::ViewportState viewportState(render);
+                    ftk::ClipRectEnabledState clipRectEnabledState(render);
+                    ftk::TransformState transformState(render);
+                    render->setRenderSize(bufferSize);
+                    render->setViewport(ftk::Box2I(0, 0, bufferSize.w, bufferSize.h));
+                    render->setClipRectEnabled(false);
+                    render->clearViewport(ftk::Color4F(0.F, 0.F, 0.F, 0.F));
+                    const ftk::V2I& viewPos = getViewPos();
+                    const double zoom = getViewZoom();
+                    const ftk::Box2I area = ftk::Box2I(
+                        box.min.x - g.min.x,
+                        box.min.y - g.min.y,
+                        box.w(),
+                        box.h());
+                    render->setTransform(
+                        ftk::ortho(
+                            static_cast<float>(area.min.x),
+                            static_cast<float>(area.max.x + 1),
+                            static_cast<float>(area.max.y + 1),
+                            static_cast<float>(area.min.y),
+                            -1.F,
+                            1.F) *
+                        ftk::translate(ftk::V3F(viewPos.x, viewPos.y, 0.F)) *
+                        ftk::scale(ftk::V3F(zoom, zoom, 1.F)));
+                    const tl::timeline::CompareOptions& compareOptions =
+                        app->getFilesModel()->getCompareOptions();
+                    render->setOCIOOptions(app->getColorModel()->getOCIOOptions());
+                    render->setLUTOptions(app->getColorModel()->getLUTOptions());
+                    render->drawVideo(
+                        p.videoData,
+                        tl::timeline::getBoxes(compareOptions.compare, p.videoData),
+                        std::vector<ftk::ImageOptions>(p.videoData.size(), p.imageOptions),
+                        std::vector<tl::timeline::DisplayOptions>(p.videoData.size(), p.displayOptions),
+                        compareOptions,
+                        bufferOptions.color);
+
+                    const size_t count = static_cast<size_t>(box.w()) * box.h();
+                    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+#if defined(FTK_API_GL_4_1)
+                    glPixelStorei(GL_PACK_SWAP_BYTES, 0);
+                    if (!readback.pbo)
+                    {
+                        glGenBuffers(1, &readback.pbo);
+                    }
+                    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+                    glBufferData(GL_PIXEL_PACK_BUFFER, count * 4 * sizeof(float), nullptr, GL_STREAM_READ);
+                    glReadPixels(0, 0, box.w(), box.h(), GL_RGBA, GL_FLOAT, nullptr);
+                    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+                    readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                    readback.count = count;
+                    readback.size = size;
+#else // FTK_API_GL_4_1
+                    // OpenGL ES can only read floating point values from
+                    // floating point buffers.
+                    std::vector<float> data(count * 4);
+                    switch (bufferOptions.color)
+                    {
+                    case ftk::ImageType::RGBA_F16:
+                    case ftk::ImageType::RGBA_F32:
+                        glReadPixels(0, 0, box.w(), box.h(), GL_RGBA, GL_FLOAT, data.data());
+                        break;
+                    default:
+                    {
+                        std::vector<uint8_t> dataU8(count * 4);
+                        glReadPixels(0, 0, box.w(), box.h(), GL_RGBA, GL_UNSIGNED_BYTE, dataU8.data());
+                        for (size_t i = 0; i < data.size(); ++i)
+                        {
+                            data[i] = dataU8[i] / 255.F;
+                        }
+                        break;
+                    }
+                    }
+                    _colorPickerDisplay(getColorPickerSample(data.data(), count, size));
+#endif // FTK_API_GL_4_1
+                }
+            }
+        }
+
+        void Viewport::_colorPickerDisplay(const ColorPickerSample& value)
+        {
+            FTK_P();
+            if (auto app = p.app.lock())
+            {
+                // Keep the source values of the current sample.
+                ColorPickerSample sample = app->getViewportModel()->getColorPicker();
+                sample.color = value.color;
+                sample.min = value.min;
+                sample.max = value.max;
+                sample.size = value.size;
+                app->getViewportModel()->setColorPicker(sample);
+            }
+        }
+
         void Viewport::_videoDataUpdate()
         {
             FTK_P();
@@ -427,20 +936,193 @@ namespace djv
                 arg(p.fps, 2, 4).
                 arg(p.droppedFrames));
 
-            p.colorPickerSwatch->setColor(p.colorPicker);
+            const ftk::Color4F& color = ColorPickerMode::Source == p.colorPickerMode ?
+                p.colorPicker.sourceColor :
+                p.colorPicker.color;
+            p.colorPickerSwatch->setColor(color);
             p.colorPickerLabel->setText(
                 ftk::Format("Color: {0} {1} {2} {3}").
-                arg(p.colorPicker.r, 2).
-                arg(p.colorPicker.g, 2).
-                arg(p.colorPicker.b, 2).
-                arg(p.colorPicker.a, 2));
+                arg(color.r, 2).
+                arg(color.g, 2).
+                arg(color.b, 2).
+                arg(color.a, 2));
 
             p.cacheLabel->setText(
                 ftk::Format("Cache: {0}% V, {1}% A").
                 arg(static_cast<int>(p.cacheInfo.videoPercentage)).
                 arg(static_cast<int>(p.cacheInfo.audioPercentage)));
 
+            p.timingLayout->setVisible(p.hudGraph);
             p.hudLayout->setVisible(p.hud);
         }
+
+        void Viewport::_timingSample()
+        {
+            FTK_P();
+            const auto now = std::chrono::steady_clock::now();
+            std::optional<OTIO_NS::RationalTime> time;
+            if (!p.videoData.empty())
+            {
+                time = p.videoData.front().time;
+            }
+            if (p.timingPrev.has_value())
+            {
+                FrameTiming timing;
+                const std::chrono::duration<double, std::milli> diff = now - p.timingPrev.value();
+                timing.interval = diff.count();
+                auto player = getPlayer();
+                const tl::timeline::Playback playback = player ?
+                    player->getPlayback() :
+                    tl::timeline::Playback::Stop;
+                if (time.has_value() &&
+                    p.timingTime.has_value() &&
+                    playback != tl::timeline::Playback::Stop)
+                {
+                    // During playback each new frame should be one frame
+                    // after the previous one. A larger step means the frames
+                    // in between were not ready in time and were skipped.
+                    // Steps in the other direction are loops or seeks.
+                    const double step =
+                        (time.value() - p.timingTime.value()).rescaled_to(time->rate()).value() *
+                        (tl::timeline::Playback::Forward == playback ? 1.0 : -1.0);
+                    if (step > 1.0)
+                    {
+                        timing.skipped = static_cast<int64_t>(std::round(step)) - 1;
+                    }
+                }
+                if (time.has_value())
+                {
+                    for (const auto& range : p.cacheInfo.video)
+                    {
+                        if (range.contains(time.value()))
+                        {
+                            timing.cacheAhead = (range.end_time_inclusive() - time.value()).
+                                rescaled_to(time->rate()).value();
+                            break;
+                        }
+                    }
+                }
+                p.timingWidget->addSample(timing);
+                p.timingDraw = true;
+
+                if (!p.timingLabelTime.has_value() ||
+                    now - p.timingLabelTime.value() >= timingLabelInterval)
+                {
+                    p.timingLabelTime = now;
+                    const auto& samples = p.timingWidget->getSamples();
+                    const FrameTimingPercentiles interval = getIntervalPercentiles(samples);
+                    const FrameTimingPercentiles draw = getDrawPercentiles(samples);
+                    int64_t skipped = 0;
+                    for (const auto& sample : samples)
+                    {
+                        skipped += sample.skipped;
+                    }
+                    p.timingLabel->setText(ftk::Format(
+                        "Frame:    {0} {1} {2} ms\n"
+                        "CPU draw: {3} {4} {5} ms\n"
+                        "Skipped:  {6}, {7} cached ahead").
+                        arg(interval.p50, 1, 5).
+                        arg(interval.p95, 1, 5).
+                        arg(interval.p99, 1, 5).
+                        arg(draw.p50, 1, 5).
+                        arg(draw.p95, 1, 5).
+                        arg(draw.p99, 1, 5).
+                        arg(skipped).
+                        arg(timing.cacheAhead));
+                }
+            }
+            p.timingPrev = now;
+            p.timingTime = time;
+        }
+
+        void Viewport::_startupProfile()
+        {
+            FTK_P();
+            auto context = getContext();
+            auto startupProfiler = context ? context->getSystem<StartupProfiler>() : nullptr;
+            if (!startupProfiler || startupProfiler->isFinished())
+            {
+                // The profiler is not looked up again once it is finished.
+                p.startupProfiling = false;
+                return;
+            }
+            if (p.firstDraw)
+            {
+                p.firstDraw = false;
+                startupProfiler->addMark("First draw", "Startup");
+            }
+            // Stop recording when the first frame is displayed, or there is
+            // no frame to display.
+            if (p.videoDataSize > 0)
+            {
+                startupProfiler->addMark("First frame", "Startup");
+                startupProfiler->finish();
+                p.startupProfiling = false;
+            }
+            else if (!p.a || FilesModelLoad::Error == p.a->load->get().status)
+            {
+                startupProfiler->finish();
+                p.startupProfiling = false;
+            }
+        }
+
+        void Viewport::_timingReset()
+        {
+            FTK_P();
+            p.timingPrev.reset();
+            p.timingLabelTime.reset();
+            p.timingTime.reset();
+            p.timingDraw = false;
+            p.timingWidget->clear();
+            p.timingLabel->setText(std::string());
+        }
+
+        void Viewport::_loadUpdate()
+        {
+            FTK_P();
+            std::string text;
+            if (p.a)
+            {
+                const std::string fileName = p.a->path.get(-1, tl::file::PathType::FileName);
+                const FilesModelLoadState& load = p.a->load->get();
+                switch (load.status)
+                {
+                case FilesModelLoad::Unloaded:
+                case FilesModelLoad::Queued:
+                    text = ftk::Format("Loading: {0}").arg(fileName);
+                    break;
+                case FilesModelLoad::Loading:
+                    // The stages are shown instead of a percentage since
+                    // the time taken by each one is not known.
+                    text = FilesModelLoadStage::None == load.stage ?
+                        ftk::Format("Loading: {0}").arg(fileName) :
+                        ftk::Format("Loading: {0} ({1})").
+                            arg(fileName).
+                            arg(getLabel(load.stage));
+                    break;
+                case FilesModelLoad::Error:
+                    text = ftk::Format("Error: {0}\n{1}").
+                        arg(fileName).
+                        arg(load.error);
+                    break;
+                default: break;
+                }
+            }
+            p.loadLabel->setText(text);
+            p.loadLabel->setVisible(!text.empty());
+            _setSizeUpdate();
+        }
+
+        void Viewport::_loadLabelGeometry()
+        {
+            FTK_P();
+            const ftk::Box2I& g = getGeometry();
+            p.loadLabelSizeHint = p.loadLabel->getSizeHint();
+            p.loadLabel->setGeometry(ftk::Box2I(
+                g.x() + g.w() / 2 - p.loadLabelSizeHint.w / 2,
+                g.y() + g.h() / 2 - p.loadLabelSizeHint.h / 2,
+                p.loadLabelSizeHint.w,
+                p.loadLabelSizeHint.h));
+        }
     }
 }
@@ -11,6 +11,8 @@ namespace djv
     {
         class App;
 
+        struct ColorPickerSample;
+
         //! Viewport.
         class Viewport : public tl::timelineui::Viewport
         {
@@ -39,10 +41,24 @@ namespace djv
             void mouseMoveEvent(ftk::MouseMoveEvent&) override;
             void mousePressEvent(ftk::MouseClickEvent&) override;
             void mouseReleaseEvent(ftk::MouseClickEvent&) override;
+            void tickEvent(
+                bool parentsVisible,
+                bool parentsEnabled,
+                const ftk::TickEvent&) override;
+            void drawEvent(const ftk::Box2I&, const ftk::DrawEvent&) override;
 
         private:
+            void _colorPickerRequest(const ftk::V2I&);
+            void _colorPickerSource(const ftk::V2I&);
+            void _colorPickerDraw(const ftk::DrawEvent&);
+            void _colorPickerDisplay(const ColorPickerSample&);
             void _videoDataUpdate();
             void _hudUpdate();
+            void _timingSample();
+            void _timingReset();
+            void _startupProfile();
+            void _loadUpdate();
+            void _loadLabelGeometry();
 
             FTK_PRIVATE();
         };
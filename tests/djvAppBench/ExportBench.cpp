@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include "ExportBench.h"
+
+#include <djvApp/Exporter.h>
+
+#include <ftk/GL/Window.h>
+#include <ftk/Core/Context.h>
+#include <ftk/Core/Format.h>
+#include <ftk/Core/String.h>
+
+#include <chrono>
+#include <iostream>
+
+using namespace djv::app;
+
+namespace djv
+{
+    namespace app_bench
+    {
+        namespace
+        {
+            ExportSettings getSequence(const std::string& extension)
+            {
+                ExportSettings out;
+                out.fileType = ExportFileType::Sequence;
+                out.imageBaseName = "render.";
+                out.imageZeroPad = 4;
+                out.imageExtension = extension;
+                return out;
+            }
+
+            ExportSettings getMovie(const std::string& extension, const std::string& codec)
+            {
+                ExportSettings out;
+                out.fileType = ExportFileType::Movie;
+                out.movieBaseName = "render";
+                out.movieExtension = extension;
+                out.movieCodec = codec;
+                return out;
+            }
+
+            bool run(
+                const std::shared_ptr<ftk::Context>& context,
+                const std::shared_ptr<tl::timeline::Timeline>& timeline,
+                const std::string& name,
+                std::vector<ExportSettings> outputs)
+            {
+                std::cout << "    " << name << ":" << std::endl;
+                bool out = false;
+                try
+                {
+                    const std::filesystem::path directory =
+                        std::filesystem::temp_directory_path() / "djvAppBench" / name;
+                    std::filesystem::create_directories(directory);
+                    for (auto& output : outputs)
+                    {
+                        output.directory = directory.u8string();
+                    }
+
+                    ExportOptions options;
+                    options.range = timeline->getTimeRange();
+                    options.speed = options.range.duration().rate();
+                    options.outputs = outputs;
+                    const auto t0 = std::chrono::steady_clock::now();
+                    auto exporter = Exporter::create(context, timeline, options);
+                    while (!exporter->isFinished())
+                    {
+                        exporter->tick();
+                    }
+                    const auto t1 = std::chrono::steady_clock::now();
+                    const std::chrono::duration<double> diff = t1 - t0;
+                    std::cout << ftk::Format("        Total: {0} frames, {1} fps").
+                        arg(exporter->getFrameTotal()).
+                        arg(exporter->getFrameTotal() / diff.count(), 1) << std::endl;
+                    const auto lines = ftk::split(
+                        getExportTimingsSummary(exporter->getTimings()),
+                        '\n');
+                    for (const auto& line : lines)
+                    {
+                        std::cout << "        " << line << std::endl;
+                    }
+                    out = true;
+                }
+                catch (const std::exception& e)
+                {
+                    std::cout << "        Skipped: " << e.what() << std::endl;
+                }
+                return out;
+            }
+        }
+
+        void exportBench(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::filesystem::path& path)
+        {
+            std::cout << "Export: " << path.u8string() << std::endl;
+
+            // Create a hidden window for the OpenGL context.
+            auto window = ftk::gl::Window::create(
+                context,
+                "djv::app_bench::exportBench",
+                ftk::Size2I(1, 1),
+                static_cast<int>(ftk::gl::WindowOptions::MakeCurrent));
+
+            auto timeline = tl::timeline::Timeline::create(
+                context,
+                tl::file::Path(path.u8string()));
+
+            ExportSettings half = getSequence(".jpg");
+            half.renderSize = ExportRenderSize::_1920_1080;
+            const std::vector<std::pair<std::string, ExportSettings> > outputs =
+            {
+                { "TIFF", getSequence(".tif") },
+                { "PNG", getSequence(".png") },
+                { "EXR", getSequence(".exr") },
+                { "JPEG_1080", half },
+                { "MJPEG", getMovie(".mov", "mjpeg") }
+            };
+
+            // Export each format separately, and then all of the supported
+            // formats from a single pass.
+            std::vector<ExportSettings> all;
+            for (const auto& output : outputs)
+            {
+                if (run(context, timeline, output.first, { output.second }))
+                {
+                    all.push_back(output.second);
+                }
+            }
+            if (all.size() > 1)
+            {
+                run(context, timeline, "All", all);
+            }
+        }
+    }
+}
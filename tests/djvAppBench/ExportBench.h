@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <filesystem>
+#include <memory>
+
+namespace ftk
+{
+    class Context;
+}
+
+namespace djv
+{
+    namespace app_bench
+    {
+        //! Benchmark exporting an image sequence to several formats.
+        void exportBench(const std::shared_ptr<ftk::Context>&, const std::filesystem::path&);
+    }
+}
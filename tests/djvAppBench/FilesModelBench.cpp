@@ -0,0 +1,165 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include "FilesModelBench.h"
+
+#include <djvApp/Models/FilesModel.h>
+
+#include <ftk/UI/Settings.h>
+#include <ftk/Core/Context.h>
+#include <ftk/Core/Format.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <unordered_map>
+
+using namespace djv::app;
+
+namespace djv
+{
+    namespace app_bench
+    {
+        namespace
+        {
+            std::vector<std::shared_ptr<FilesModelItem> > getItems(size_t count)
+            {
+                std::vector<std::shared_ptr<FilesModelItem> > out;
+                out.reserve(count);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    auto item = std::make_shared<FilesModelItem>();
+                    item->path = tl::file::Path(ftk::Format("/tmp/djvAppBench/file.{0}.exr").arg(i));
+                    out.push_back(item);
+                }
+                return out;
+            }
+
+            struct Stats
+            {
+                size_t filesCallbacks = 0;
+                size_t activeCallbacks = 0;
+            };
+
+            std::shared_ptr<FilesModel> createModel(
+                const std::shared_ptr<ftk::Settings>& settings,
+                Stats& stats,
+                std::vector<std::shared_ptr<void> >& observers)
+            {
+                auto out = FilesModel::create(settings);
+
+                // Simulate the work done by the application when the files
+                // change: rebuild an index of the files.
+                observers.push_back(ftk::ListObserver<std::shared_ptr<FilesModelItem> >::create(
+                    out->observeFiles(),
+                    [&stats](const std::vector<std::shared_ptr<FilesModelItem> >& value)
+                    {
+                        std::unordered_map<std::shared_ptr<FilesModelItem>, size_t> indexes;
+                        indexes.reserve(value.size());
+                        for (size_t i = 0; i < value.size(); ++i)
+                        {
+                            indexes[value[i]] = i;
+                        }
+                        ++stats.filesCallbacks;
+                    }));
+                observers.push_back(ftk::ListObserver<std::shared_ptr<FilesModelItem> >::create(
+                    out->observeActive(),
+                    [&stats](const std::vector<std::shared_ptr<FilesModelItem> >&)
+                    {
+                        ++stats.activeCallbacks;
+                    }));
+                return out;
+            }
+
+            void print(const std::string& name, const Stats& stats, const std::chrono::steady_clock::time_point& t0)
+            {
+                const auto t1 = std::chrono::steady_clock::now();
+                const std::chrono::duration<double, std::milli> diff = t1 - t0;
+                std::cout << ftk::Format("{0}: {1}ms, {2} files callbacks, {3} active callbacks").
+                    arg(name).
+                    arg(diff.count(), 2).
+                    arg(stats.filesCallbacks).
+                    arg(stats.activeCallbacks) << std::endl;
+            }
+        }
+
+        void filesModelBench(const std::shared_ptr<ftk::Context>& context, size_t count)
+        {
+            const std::filesystem::path settingsPath =
+                std::filesystem::temp_directory_path() / "djvAppBench.json";
+            auto settings = ftk::Settings::create(context, settingsPath, true);
+            std::cout << "Files model: " << count << " items" << std::endl;
+            {
+                Stats stats;
+                std::vector<std::shared_ptr<void> > observers;
+                auto model = createModel(settings, stats, observers);
+                const auto items = getItems(count);
+                const auto t0 = std::chrono::steady_clock::now();
+                for (const auto& item : items)
+                {
+                    model->add(item);
+                }
+                print("    Add one at a time", stats, t0);
+            }
+            {
+                Stats stats;
+                std::vector<std::shared_ptr<void> > observers;
+                auto model = createModel(settings, stats, observers);
+                const auto items = getItems(count);
+                const auto t0 = std::chrono::steady_clock::now();
+                model->add(items);
+                print("    Add batch", stats, t0);
+            }
+
+            // The lookups are measured with a single B file, so the time is
+            // not dominated by rebuilding the B list.
+            {
+                Stats stats;
+                std::vector<std::shared_ptr<void> > observers;
+                auto model = createModel(settings, stats, observers);
+                model->add(getItems(count));
+                model->setB(0, true);
+                stats = Stats();
+                const auto t0 = std::chrono::steady_clock::now();
+                for (size_t i = 0; i < count; ++i)
+                {
+                    model->setA(static_cast<int>(i));
+                }
+                print("    Set A", stats, t0);
+            }
+            {
+                Stats stats;
+                std::vector<std::shared_ptr<void> > observers;
+                auto model = createModel(settings, stats, observers);
+                model->add(getItems(count));
+                model->setB(0, true);
+                stats = Stats();
+                const auto t0 = std::chrono::steady_clock::now();
+                for (size_t i = 0; i < count; ++i)
+                {
+                    model->toggleB(static_cast<int>(i));
+                }
+                print("    Toggle B", stats, t0);
+            }
+            {
+                // Close the files in the middle of the list, which is the
+                // worst case for updating the indexes.
+                const size_t closeCount = std::min(count, static_cast<size_t>(100));
+                Stats stats;
+                std::vector<std::shared_ptr<void> > observers;
+                auto model = createModel(settings, stats, observers);
+                model->add(getItems(count));
+                model->setA(0);
+                model->setB(static_cast<int>(count - 1), true);
+                stats = Stats();
+                const auto t0 = std::chrono::steady_clock::now();
+                for (size_t i = 0; i < closeCount; ++i)
+                {
+                    model->close(static_cast<int>(model->getFiles().size() / 2));
+                }
+                print(ftk::Format("    Close {0}").arg(closeCount), stats, t0);
+            }
+        }
+    }
+}
@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <memory>
+
+namespace ftk
+{
+    class Context;
+}
+
+namespace djv
+{
+    namespace app_bench
+    {
+        //! Benchmark adding files to the files model.
+        void filesModelBench(const std::shared_ptr<ftk::Context>&, size_t count);
+    }
+}
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include "ExportBench.h"
+#include "FilesModelBench.h"
+
+#include <tlTimelineUI/Init.h>
+
+#include <ftk/Core/Context.h>
+#include <ftk/Core/Error.h>
+
+#include <iostream>
+
+FTK_MAIN()
+{
+    int r = 1;
+    try
+    {
+        auto context = ftk::Context::create();
+        tl::timelineui::init(context);
+        djv::app_bench::filesModelBench(context, 10000);
+        djv::app_bench::exportBench(
+            context,
+            std::filesystem::u8path(DJV_SAMPLE_DATA) / "BART_2021-02-07.0000.jpg");
+        r = 0;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+    }
+    return r;
+}